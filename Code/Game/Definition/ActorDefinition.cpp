@@ -7,6 +7,7 @@
 
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Game/Framework/AnimationGroup.hpp"
 #include "Game/Framework/GameCommon.hpp"
@@ -77,6 +78,7 @@ bool ActorDefinition::LoadFromXmlElement(XmlElement const* element)
         m_aiEnabled   = ParseXmlAttribute(*aiElement, "aiEnabled", false);
         m_sightRadius = ParseXmlAttribute(*aiElement, "sightRadius", -1.f);
         m_sightAngle  = ParseXmlAttribute(*aiElement, "sightAngle", -1.f);
+        m_sightCosine = CosDegrees(m_sightAngle * 0.5f);
     }
 
     XmlElement const* visualElement = element->FirstChildElement("Visuals");
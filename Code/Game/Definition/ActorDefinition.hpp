@@ -67,6 +67,7 @@ public:
     bool  m_aiEnabled   = false;
     float m_sightRadius = 0.f;
     float m_sightAngle  = 0.f;
+    float m_sightCosine = -1.f;     // Cosine of half the sight angle, so perception can test the FOV cone with a dot product.
 
     // Visuals
     Vec2                        m_size          = Vec2::ZERO;               // Size of the actor sprite, in world units.
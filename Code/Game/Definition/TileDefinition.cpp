@@ -9,7 +9,8 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
 //----------------------------------------------------------------------------------------------------
-std::vector<TileDefinition*> TileDefinition::s_tileDefinitions;
+std::vector<TileDefinition*>              TileDefinition::s_tileDefinitions;
+std::unordered_map<unsigned int, uint8_t> TileDefinition::s_tileDefIndicesByColor;
 
 //----------------------------------------------------------------------------------------------------
 TileDefinition::~TileDefinition()
@@ -68,6 +69,19 @@ STATIC void TileDefinition::InitializeTileDefs(char const* path)
         tileDefinitionElement = tileDefinitionElement->NextSiblingElement();
     }
 
+    if (s_tileDefinitions.size() >= INVALID_DEF_INDEX)
+    {
+        ERROR_AND_DIE("Too many tile definitions for an 8-bit tile index")
+    }
+
+    // Later definitions win on a shared color, the same as the old per-pixel scan over every definition.
+    s_tileDefIndicesByColor.clear();
+
+    for (int defIndex = 0; defIndex < static_cast<int>(s_tileDefinitions.size()); ++defIndex)
+    {
+        s_tileDefIndicesByColor[GetColorKey(s_tileDefinitions[defIndex]->m_mapImagePixelColor)] = static_cast<uint8_t>(defIndex);
+    }
+
     // XmlDocument mapDefXml;
     //
     // if (mapDefXml.LoadFile("Data/Definitions/TileDefinitions.xml") != XmlResult::XML_SUCCESS)
@@ -115,3 +129,41 @@ StringList TileDefinition::GetTileNames()
 
     return tileNames;
 }
+
+//----------------------------------------------------------------------------------------------------
+// Returns INVALID_DEF_INDEX if no tile definition uses this color.
+uint8_t TileDefinition::GetDefIndexByColor(Rgba8 const& color)
+{
+    auto const found = s_tileDefIndicesByColor.find(GetColorKey(color));
+
+    if (found == s_tileDefIndicesByColor.end())
+    {
+        return INVALID_DEF_INDEX;
+    }
+
+    return found->second;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns INVALID_DEF_INDEX if no tile definition has this name.
+uint8_t TileDefinition::GetDefIndexByName(String const& name)
+{
+    for (int defIndex = 0; defIndex < static_cast<int>(s_tileDefinitions.size()); ++defIndex)
+    {
+        if (s_tileDefinitions[defIndex]->m_name == name)
+        {
+            return static_cast<uint8_t>(defIndex);
+        }
+    }
+
+    return INVALID_DEF_INDEX;
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned int TileDefinition::GetColorKey(Rgba8 const& color)
+{
+    return static_cast<unsigned int>(color.r) << 24 |
+           static_cast<unsigned int>(color.g) << 16 |
+           static_cast<unsigned int>(color.b) << 8 |
+           static_cast<unsigned int>(color.a);
+}
@@ -4,6 +4,9 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <cstdint>
+#include <unordered_map>
+
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Math/IntVec2.hpp"
@@ -19,8 +22,15 @@ struct TileDefinition
     static void                         InitializeTileDefs(char const* path);
     static TileDefinition const*        GetDefByName(String const& name);
     static StringList                   GetTileNames();
+    static uint8_t                      GetDefIndexByColor(Rgba8 const& color);
+    static uint8_t                      GetDefIndexByName(String const& name);
+    static unsigned int                 GetColorKey(Rgba8 const& color);
     static std::vector<TileDefinition*> s_tileDefinitions;
 
+    // Map image color (packed by GetColorKey) to index in s_tileDefinitions, built once by InitializeTileDefs.
+    static std::unordered_map<unsigned int, uint8_t> s_tileDefIndicesByColor;
+    static constexpr uint8_t                         INVALID_DEF_INDEX = 0xffu;
+
     String  m_name;
     bool    m_isSolid;
     Rgba8   m_mapImagePixelColor;
@@ -9,6 +9,7 @@
 #include "Game/Definition/ActorDefinition.hpp"
 #include "Game/Definition/WeaponDefinition.hpp"
 #include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/ActorCommandBuffer.hpp"
 #include "Game/Gameplay/Map.hpp"
 #include "Game/Gameplay/Weapon.hpp"
 
@@ -18,23 +19,24 @@ AIController::AIController(Map* map)
 {
 }
 
+//----------------------------------------------------------------------------------------------------
 void AIController::Update(float const deltaSeconds)
+{
+    UpdateSteering(deltaSeconds, nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------
+// With a command buffer this runs in the parallel actor update phase: it only turns and pushes the possessed actor, and
+// records a command for anything else (a path query, firing a weapon). Without one it does everything immediately.
+void AIController::UpdateSteering(float const         deltaSeconds,
+                                  ActorCommandBuffer* commands)
 {
     Actor* possessedActor = m_map->GetActorByHandle(m_actorHandle);
 
     if (possessedActor == nullptr) return;
     if (possessedActor->m_isDead) return;
 
-    Actor const* target = m_map->GetClosestVisibleEnemy(possessedActor);
-
-    if (target != nullptr &&
-        // m_targetActorHandle.IsValid() &&
-        m_targetActorHandle != target->m_handle &&
-        !target->m_isDead)
-    {
-        m_targetActorHandle = target->m_handle;
-    }
-
+    // Perception runs in RefreshTarget on the map's AI scheduler; steering here uses the cached target.
     Actor const* targetActor = m_map->GetActorByHandle(m_targetActorHandle);
 
     if (!targetActor ||
@@ -49,7 +51,28 @@ void AIController::Update(float const deltaSeconds)
     Vec3        possessedActorToTargetActor = targetActor->m_position - possessedActor->m_position;
     possessedActorToTargetActor.z           = 0.f;
 
-    float const targetActorYaw    = Atan2Degrees(possessedActorToTargetActor.y, possessedActorToTargetActor.x);
+    // Follow the target's flow field around walls when it has one (players), otherwise a cached A* path
+    // (e.g. a demon hit by another actor), and walk straight at it once in the same tile.
+    Vec2 steeringDirection = m_map->GetFlowDirectionToward(m_targetActorHandle, possessedActor->m_position);
+
+    if (steeringDirection == Vec2::ZERO)
+    {
+        if (commands != nullptr)
+        {
+            commands->AddCommand(eActorCommandType::STEER_WITH_PATH, m_actorHandle);
+            return;
+        }
+
+        steeringDirection = m_map->GetPathDirectionToward(possessedActor->m_position, targetActor->m_position);
+    }
+
+    if (steeringDirection == Vec2::ZERO)
+    {
+        steeringDirection = Vec2(possessedActorToTargetActor.x, possessedActorToTargetActor.y);
+    }
+
+
+    float const targetActorYaw    = Atan2Degrees(steeringDirection.y, steeringDirection.x);
     float const possessedActorYaw = possessedActor->m_orientation.m_yawDegrees;
     float const newYaw            = GetTurnedTowardDegrees(possessedActorYaw, targetActorYaw, maxTurnDegreesThisFrame);
 
@@ -73,12 +96,39 @@ void AIController::Update(float const deltaSeconds)
     {
         if (distanceToTarget < possessedActor->m_currentWeapon->m_definition->m_meleeRange + targetActor->m_radius)
         {
-            possessedActor->m_currentWeapon->Fire();
-            possessedActor->PlayAnimationByName("Attack", true);
+            if (commands != nullptr)
+            {
+                commands->AddCommand(eActorCommandType::FIRE_WEAPON, m_actorHandle);
+            }
+            else
+            {
+                possessedActor->m_currentWeapon->Fire();
+                possessedActor->PlayAnimationByName("Attack", true);
+            }
         }
     }
 }
 
+//----------------------------------------------------------------------------------------------------
+// Re-acquire the closest visible enemy. Called by Map's AIScheduler, round-robin and within its per-frame budget.
+void AIController::RefreshTarget(PerceptionScratch& scratch)
+{
+    Actor const* possessedActor = m_map->GetActorByHandle(m_actorHandle);
+
+    if (possessedActor == nullptr) return;
+    if (possessedActor->m_isDead) return;
+
+    Actor const* target = m_map->GetClosestVisibleEnemy(possessedActor, scratch);
+
+    if (target != nullptr &&
+        // m_targetActorHandle.IsValid() &&
+        m_targetActorHandle != target->m_handle &&
+        !target->m_isDead)
+    {
+        m_targetActorHandle = target->m_handle;
+    }
+}
+
 //----------------------------------------------------------------------------------------------------
 // Notification that the AI actor was damaged so this AI can target them.
 void AIController::DamagedBy(ActorHandle const& attacker)
@@ -6,6 +6,10 @@
 #pragma once
 #include "Game/Framework/Controller.hpp"
 
+//-Forward-Declaration--------------------------------------------------------------------------------
+class ActorCommandBuffer;
+struct PerceptionScratch;
+
 //----------------------------------------------------------------------------------------------------
 // AI controllers should be constructed by the actor when the actor is spawned and immediately possess that actor.
 class AIController final : public Controller
@@ -15,6 +19,8 @@ public:
     explicit AIController(Map* map);
 
     void Update(float deltaSeconds) override;
+    void UpdateSteering(float deltaSeconds, ActorCommandBuffer* commands);
+    void RefreshTarget(PerceptionScratch& scratch);
     void DamagedBy(ActorHandle const& attacker);
 
     ActorHandle m_targetActorHandle;
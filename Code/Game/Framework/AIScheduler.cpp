@@ -0,0 +1,133 @@
+//----------------------------------------------------------------------------------------------------
+// AIScheduler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/AIScheduler.hpp"
+
+#include "Engine/Core/Time.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Framework/AIController.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/Map.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void AIScheduler::Initialize(float const refreshIntervalSeconds,
+                             float const budgetMicroseconds)
+{
+    m_refreshIntervalSeconds = refreshIntervalSeconds > 0.f ? refreshIntervalSeconds : 0.f;
+    m_budgetMicroseconds     = budgetMicroseconds;
+    m_actorHandles.clear();
+    m_cursor              = 0;
+    m_pendingRefreshCount = 0.f;
+    m_lastRefreshCount    = 0;
+    m_queueDepth          = 0;
+    m_budgetOverrunCount  = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIScheduler::RegisterActor(ActorHandle const& actorHandle)
+{
+    m_actorHandles.push_back(actorHandle);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each AI is owed deltaSeconds / interval refreshes per frame, so the whole list is covered once per interval.
+// At least one refresh always runs, so a tiny budget slows perception down instead of stopping it.
+void AIScheduler::Update(Map const&  map,
+                         float const deltaSeconds)
+{
+    int const registeredCount = static_cast<int>(m_actorHandles.size());
+
+    m_lastRefreshCount = 0;
+
+    if (registeredCount == 0)
+    {
+        m_pendingRefreshCount = 0.f;
+        m_queueDepth          = 0;
+        return;
+    }
+
+    // 1. Accumulate the refreshes owed this frame. A whole pass is the most that can ever be useful.
+    if (m_refreshIntervalSeconds > 0.f)
+    {
+        m_pendingRefreshCount += static_cast<float>(registeredCount) * deltaSeconds / m_refreshIntervalSeconds;
+    }
+    else
+    {
+        m_pendingRefreshCount = static_cast<float>(registeredCount);
+    }
+
+    if (m_pendingRefreshCount > static_cast<float>(registeredCount))
+    {
+        m_pendingRefreshCount = static_cast<float>(registeredCount);
+    }
+
+    int const    dueCount         = static_cast<int>(m_pendingRefreshCount);
+    double const startTimeSeconds = GetCurrentTimeSeconds();
+
+    // 2. Refresh round-robin until the due refreshes are done or the budget is spent.
+    while (m_lastRefreshCount < dueCount && m_lastRefreshCount < static_cast<int>(m_actorHandles.size()))
+    {
+        if (m_lastRefreshCount > 0)
+        {
+            double const elapsedMicroseconds = (GetCurrentTimeSeconds() - startTimeSeconds) * 1000000.0;
+
+            if (elapsedMicroseconds > static_cast<double>(m_budgetMicroseconds))
+            {
+                m_budgetOverrunCount++;
+                break;
+            }
+        }
+
+        if (m_cursor >= static_cast<int>(m_actorHandles.size())) m_cursor = 0;
+
+        Actor* actor = map.GetActorByHandle(m_actorHandles[m_cursor]);
+
+        // Destroyed actors leave the list; the entry swapped in takes this turn.
+        if (actor == nullptr || actor->m_aiController == nullptr)
+        {
+            m_actorHandles[m_cursor] = m_actorHandles.back();
+            m_actorHandles.pop_back();
+            continue;
+        }
+
+        // Actors possessed by a player keep their place in the list but do not perceive.
+        if (!actor->m_isDead && actor->m_definition->m_aiEnabled && actor->m_controller == actor->m_aiController)
+        {
+            actor->m_aiController->RefreshTarget(m_perceptionScratch);
+        }
+
+        m_cursor++;
+        m_lastRefreshCount++;
+    }
+
+    m_pendingRefreshCount -= static_cast<float>(m_lastRefreshCount);
+    m_queueDepth = dueCount - m_lastRefreshCount;
+
+    if (m_queueDepth < 0) m_queueDepth = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIScheduler::GetRegisteredCount() const
+{
+    return static_cast<int>(m_actorHandles.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIScheduler::GetQueueDepth() const
+{
+    return m_queueDepth;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIScheduler::GetLastRefreshCount() const
+{
+    return m_lastRefreshCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIScheduler::GetBudgetOverrunCount() const
+{
+    return m_budgetOverrunCount;
+}
@@ -0,0 +1,58 @@
+//----------------------------------------------------------------------------------------------------
+// AIScheduler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Game/Framework/ActorHandle.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+class Map;
+
+//----------------------------------------------------------------------------------------------------
+// An enemy that passed the distance, FOV and faction tests and still needs a line of sight raycast.
+struct PerceptionCandidate
+{
+    float        m_distanceSquared = 0.f;
+    Actor const* m_actor           = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Lists reused by Map::GetClosestVisibleEnemy. The caller owns them, so perception never shares scratch with other map queries.
+struct PerceptionScratch
+{
+    std::vector<unsigned int>        m_actorIndices;
+    std::vector<PerceptionCandidate> m_candidates;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Staggers AI perception across frames. Every registered AI re-acquires its target once per refresh interval,
+// round-robin, and the refreshes due this frame stop early once the per-frame microsecond budget is spent.
+// Refreshes that miss the budget stay queued for the next frame. Steering still runs every frame in
+// AIController::Update against the cached target.
+class AIScheduler
+{
+public:
+    void Initialize(float refreshIntervalSeconds, float budgetMicroseconds);
+    void RegisterActor(ActorHandle const& actorHandle);
+    void Update(Map const& map, float deltaSeconds);
+
+    int GetRegisteredCount() const;
+    int GetQueueDepth() const;
+    int GetLastRefreshCount() const;
+    int GetBudgetOverrunCount() const;
+
+private:
+    std::vector<ActorHandle> m_actorHandles;                // Round-robin order; dead actors are swapped out when reached.
+    int                      m_cursor                 = 0;
+    float                    m_refreshIntervalSeconds = 0.2f;
+    float                    m_budgetMicroseconds     = 500.f;
+    float                    m_pendingRefreshCount    = 0.f;    // Refreshes owed, including the fraction carried between frames.
+    int                      m_lastRefreshCount       = 0;      // Refreshes run last frame.
+    int                      m_queueDepth             = 0;      // Refreshes that were due but did not fit in last frame's budget.
+    int                      m_budgetOverrunCount     = 0;      // Frames that stopped early because the budget was spent.
+    PerceptionScratch        m_perceptionScratch;               // Passed to every RefreshTarget this scheduler runs.
+};
@@ -15,10 +15,10 @@ ActorHandle::ActorHandle()
 }
 
 //----------------------------------------------------------------------------------------------------
-ActorHandle::ActorHandle(unsigned int const uid,
+ActorHandle::ActorHandle(unsigned int const generation,
                          unsigned int const index)
 {
-    m_data = (uid << 16) | (index & 0x0000ffff);
+    m_data = (generation << 16) | (index & 0x0000ffff);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -27,6 +27,12 @@ bool ActorHandle::IsValid() const
     return *this != INVALID;
 }
 
+//----------------------------------------------------------------------------------------------------
+unsigned int ActorHandle::GetGeneration() const
+{
+    return m_data >> 16;
+}
+
 //----------------------------------------------------------------------------------------------------
 unsigned int ActorHandle::GetIndex() const
 {
@@ -6,14 +6,18 @@
 #pragma once
 
 //----------------------------------------------------------------------------------------------------
+// The upper 16 bits store the generation of the actor slot, the lower 16 bits store the slot index.
+// A slot's generation is bumped every time its actor is destroyed, so stale handles never resolve to the slot's next actor.
 struct ActorHandle
 {
     ActorHandle();
-    ActorHandle(unsigned int uid, unsigned int index);
+    ActorHandle(unsigned int generation, unsigned int index);
 
     static const ActorHandle INVALID;
+    static constexpr unsigned int MAX_GENERATION = 0x0000fffeu;
 
     bool         IsValid() const;
+    unsigned int GetGeneration() const;
     unsigned int GetIndex() const;
     bool         operator==(ActorHandle const& other) const;
     bool         operator!=(ActorHandle const& other) const;
@@ -17,16 +17,23 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Window.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/JobSystem.hpp"
+#include "Game/Framework/RenderStats.hpp"
+#include "Game/Gameplay/ActorBodySet.hpp"
 #include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/OccupancyPyramid.hpp"
+#include "Game/Gameplay/TilePathfinder.hpp"
 
 //----------------------------------------------------------------------------------------------------
 App*                   g_theApp          = nullptr;       // Created and owned by Main_Windows.cpp
 AudioSystem*           g_theAudio        = nullptr;       // Created and owned by the App
 BitmapFont*            g_theBitmapFont   = nullptr;       // Created and owned by the App
 Game*                  g_theGame         = nullptr;       // Created and owned by the App
+JobSystem*             g_theJobSystem    = nullptr;       // Created and owned by the App
 Renderer*              g_theRenderer     = nullptr;       // Created and owned by the App
 Window*                g_theWindow       = nullptr;       // Created and owned by the App
 RandomNumberGenerator* g_theRNG= nullptr;
+RenderStats            g_renderStats;                     // Reset by the App every frame
 
 //----------------------------------------------------------------------------------------------------
 STATIC bool App::m_isQuitting = false;
@@ -41,6 +48,9 @@ void App::Startup()
     g_theEventSystem = new EventSystem(eventSystemConfig);
     g_theEventSystem->SubscribeEventCallbackFunction("OnCloseButtonClicked", OnCloseButtonClicked);
     g_theEventSystem->SubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
+#if defined(GAME_BENCHMARKS)
+    g_theEventSystem->SubscribeEventCallbackFunction("benchmark", OnBenchmarkCommand);
+#endif
 
     InputSystemConfig inputConfig;
     g_theInput = new InputSystem(inputConfig);
@@ -87,9 +97,13 @@ void App::Startup()
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(O)     Step Frame");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(F)     Toggle Free Camera");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(N)     Possess Next Actor");
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(I)     Toggle Stats Overlay");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(~)     Toggle Dev Console");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(ESC)   Exit Game");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(SPACE) Start Game");
+#if defined(GAME_BENCHMARKS)
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "benchmark  Run the pathfinding, raycast, physics and job benchmarks");
+#endif
 
     AudioSystemConfig audioConfig;
     g_theAudio = new AudioSystem(audioConfig);
@@ -104,6 +118,7 @@ void App::Startup()
 
     g_theBitmapFont = g_theRenderer->CreateOrGetBitmapFontFromFile("Data/Fonts/SquirrelFixedFont"); // DO NOT SPECIFY FILE .EXTENSION!!  (Important later on.)
     g_theRNG        = new RandomNumberGenerator();
+    g_theJobSystem  = new JobSystem(GetJobWorkerThreadCount());
     g_theGame       = new Game();
 
     m_devConsoleCamera->SetNormalizedViewport(AABB2(Vec2::ZERO, Vec2::ONE));
@@ -118,6 +133,9 @@ void App::Shutdown()
     delete g_theGame;
     g_theGame = nullptr;
 
+    delete g_theJobSystem;
+    g_theJobSystem = nullptr;
+
     delete g_theRNG;
     g_theRNG = nullptr;
 
@@ -181,6 +199,23 @@ STATIC bool App::OnCloseButtonClicked(EventArgs& args)
     return true;
 }
 
+#if defined(GAME_BENCHMARKS)
+//----------------------------------------------------------------------------------------------------
+// Dev builds only. The benchmarks build their own data and block the frame for several seconds, so they are a console
+// command rather than a gameplay key.
+STATIC bool App::OnBenchmarkCommand(EventArgs& args)
+{
+    UNUSED(args)
+
+    TilePathfinder::RunBenchmark();
+    OccupancyPyramid::RunBenchmark();
+    ActorBodySet::RunBenchmark();
+    JobSystem::RunBenchmark();
+
+    return true;
+}
+#endif
+
 //----------------------------------------------------------------------------------------------------
 STATIC void App::RequestQuit()
 {
@@ -197,6 +232,7 @@ void App::BeginFrame() const
     g_theDevConsole->BeginFrame();
     g_theInput->BeginFrame();
     g_theAudio->BeginFrame();
+    g_renderStats.BeginFrame();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -288,3 +324,16 @@ void App::LoadGameConfig(char const* gameConfigXmlFilePath)
         DebuggerPrintf("WARNING: failed to load game config from file \"%s\"\n", gameConfigXmlFilePath);
     }
 }
+
+//----------------------------------------------------------------------------------------------------
+// Jobs.WorkerThreadCount from the game config; a negative value means one worker per hardware thread besides the main one.
+int App::GetJobWorkerThreadCount() const
+{
+    int const workerThreadCount = g_gameConfigBlackboard.GetValue("Jobs.WorkerThreadCount", -1);
+
+    if (workerThreadCount >= 0) return workerThreadCount;
+
+    int const hardwareThreadCount = static_cast<int>(std::thread::hardware_concurrency());
+
+    return hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0;
+}
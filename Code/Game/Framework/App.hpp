@@ -22,6 +22,9 @@ public:
     void RunMainLoop();
 
     static bool OnCloseButtonClicked(EventArgs& args);
+#if defined(GAME_BENCHMARKS)
+    static bool OnBenchmarkCommand(EventArgs& args);
+#endif
     static void RequestQuit();
     static bool m_isQuitting;
 
@@ -34,6 +37,7 @@ private:
     void UpdateCursorMode();
     void DeleteAndCreateNewGame();
     void LoadGameConfig(char const* gameConfigXmlFilePath);
+    int  GetJobWorkerThreadCount() const;
 
     Camera* m_devConsoleCamera = nullptr;
 };
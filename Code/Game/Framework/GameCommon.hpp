@@ -10,16 +10,20 @@ class App;
 class AudioSystem;
 class BitmapFont;
 class Game;
+class JobSystem;
 class Renderer;
 class RandomNumberGenerator;
+struct RenderStats;
 
 // one-time declaration
 extern App*                   g_theApp;
 extern AudioSystem*           g_theAudio;
 extern BitmapFont*            g_theBitmapFont;
 extern Game*                  g_theGame;
+extern JobSystem*             g_theJobSystem;
 extern Renderer*              g_theRenderer;
 extern RandomNumberGenerator* g_theRNG;
+extern RenderStats            g_renderStats;
 
 //----------------------------------------------------------------------------------------------------
 template <typename T>
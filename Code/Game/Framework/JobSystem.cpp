@@ -0,0 +1,316 @@
+//----------------------------------------------------------------------------------------------------
+// JobSystem.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/JobSystem.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Gameplay/ActorBodySet.hpp"
+
+//----------------------------------------------------------------------------------------------------
+JobSystem::JobSystem(int const workerThreadCount)
+{
+    int const threadCount = workerThreadCount > 0 ? workerThreadCount : 0;
+
+    for (int queueIndex = 0; queueIndex <= threadCount; ++queueIndex)
+    {
+        m_queues.push_back(std::make_unique<JobQueue>());
+    }
+
+    for (int workerIndex = 0; workerIndex < threadCount; ++workerIndex)
+    {
+        m_workerThreads.emplace_back(&JobSystem::WorkerThreadMain, this, workerIndex + 1);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> const lock(m_wakeMutex);
+        m_isQuitting = true;
+    }
+
+    m_wakeCondition.notify_all();
+
+    for (std::thread& workerThread : m_workerThreads)
+    {
+        workerThread.join();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Splits [0, itemCount) into chunks of chunkSize items and returns once every chunk has run. Chunks are dealt round-robin over
+// all the deques, the caller's included, and idle threads steal from the others. Must be called from one thread at a time,
+// and not from inside a job.
+void JobSystem::ParallelFor(int const            itemCount,
+                            int const            chunkSize,
+                            ChunkFunction const& function)
+{
+    int const chunkCount = GetChunkCount(itemCount, chunkSize);
+
+    m_lastJobCount   = chunkCount;
+    m_lastStealCount = 0;
+
+    if (chunkCount == 0) return;
+
+    // 1. Without workers there is nobody to share with, so run the chunks in order right here.
+    if (m_workerThreads.empty())
+    {
+        for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+        {
+            int const beginIndex = chunkIndex * chunkSize;
+            int const endIndex   = beginIndex + chunkSize < itemCount ? beginIndex + chunkSize : itemCount;
+
+            function(chunkIndex, beginIndex, endIndex);
+        }
+
+        return;
+    }
+
+    // 2. Deal the chunks out and wake the workers.
+    m_stealCount         = 0;
+    m_unfinishedJobCount = chunkCount;
+
+    int const queueCount = static_cast<int>(m_queues.size());
+
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        Job job;
+        job.m_function   = &function;
+        job.m_chunkIndex = chunkIndex;
+        job.m_beginIndex = chunkIndex * chunkSize;
+        job.m_endIndex   = job.m_beginIndex + chunkSize < itemCount ? job.m_beginIndex + chunkSize : itemCount;
+
+        JobQueue&                         queue = *m_queues[chunkIndex % queueCount];
+        std::lock_guard<std::mutex> const lock(queue.m_mutex);
+        queue.m_jobs.push_back(job);
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock(m_wakeMutex);
+        m_queuedJobCount += chunkCount;
+    }
+
+    m_wakeCondition.notify_all();
+
+    // 3. Help out until the last chunk has returned.
+    while (m_unfinishedJobCount > 0)
+    {
+        if (!TryRunJob(0))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    m_lastStealCount = m_stealCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Worker threads plus the calling thread.
+int JobSystem::GetThreadCount() const
+{
+    return static_cast<int>(m_workerThreads.size()) + 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+int JobSystem::GetLastJobCount() const
+{
+    return m_lastJobCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int JobSystem::GetLastStealCount() const
+{
+    return m_lastStealCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int JobSystem::GetChunkCount(int const itemCount,
+                                    int const chunkSize)
+{
+    if (itemCount <= 0 || chunkSize <= 0) return 0;
+
+    return (itemCount + chunkSize - 1) / chunkSize;
+}
+
+#if defined(GAME_BENCHMARKS)
+//----------------------------------------------------------------------------------------------------
+// Scaling of the parallel actor update phase on 1, 2, 4 and 8 threads: 10k actors steer toward random targets (the turn
+// and move math of AIController::Update), then their bodies are integrated, in chunks, for 100 frames. Every thread count
+// must end with the same positions as the single thread run.
+STATIC void JobSystem::RunBenchmark()
+{
+    int const   threadCounts[] = { 1, 2, 4, 8 };
+    int const   actorCount     = 10000;
+    int const   frameCount     = 100;
+    int const   chunkSize      = 256;      // A multiple of ActorBodySet::LANE_COUNT, so integration chunks never share a block.
+    float const deltaSeconds   = 1.f / 60.f;
+
+    std::vector<Vec3> startPositions(actorCount);
+    std::vector<Vec3> targetPositions(actorCount);
+
+    for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+    {
+        startPositions[actorIndex]  = Vec3(g_theRNG->RollRandomFloatInRange(0.f, 64.f), g_theRNG->RollRandomFloatInRange(0.f, 64.f), 0.f);
+        targetPositions[actorIndex] = Vec3(g_theRNG->RollRandomFloatInRange(0.f, 64.f), g_theRNG->RollRandomFloatInRange(0.f, 64.f), 0.f);
+    }
+
+    double            singleThreadSeconds = 0.0;
+    std::vector<Vec3> singleThreadPositions;
+
+    for (int const threadCount : threadCounts)
+    {
+        JobSystem          jobSystem(threadCount - 1);
+        ActorBodySet       bodies;
+        std::vector<float> yaws(actorCount, 0.f);
+
+        for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+        {
+            bodies.AddBody(static_cast<unsigned int>(actorIndex), startPositions[actorIndex], Vec3::ZERO, 0.5f, 1.f, 9.f,
+                           ActorBodySet::BODY_SIMULATED | ActorBodySet::BODY_PINNED_TO_FLOOR);
+        }
+
+        ChunkFunction const steerChunk = [&](int, int const beginIndex, int const endIndex)
+        {
+            for (int actorIndex = beginIndex; actorIndex < endIndex; ++actorIndex)
+            {
+                Vec3 const  toTarget  = targetPositions[actorIndex] - bodies.GetPosition(static_cast<unsigned int>(actorIndex));
+                float const targetYaw = Atan2Degrees(toTarget.y, toTarget.x);
+
+                yaws[actorIndex] = GetTurnedTowardDegrees(yaws[actorIndex], targetYaw, 180.f * deltaSeconds);
+                bodies.AddForce(static_cast<unsigned int>(actorIndex), Vec3(CosDegrees(yaws[actorIndex]), SinDegrees(yaws[actorIndex]), 0.f) * 9.f);
+            }
+        };
+
+        ChunkFunction const integrateChunk = [&](int, int const beginIndex, int const endIndex)
+        {
+            bodies.IntegrateRange(deltaSeconds, beginIndex, endIndex);
+        };
+
+        double const startSeconds = GetCurrentTimeSeconds();
+
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+        {
+            jobSystem.ParallelFor(actorCount, chunkSize, steerChunk);
+            jobSystem.ParallelFor(bodies.GetSlotCount(), chunkSize, integrateChunk);
+        }
+
+        double const seconds = GetCurrentTimeSeconds() - startSeconds;
+
+        // Compare against the single thread run.
+        int mismatchCount = 0;
+
+        if (singleThreadPositions.empty())
+        {
+            singleThreadSeconds = seconds;
+
+            for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+            {
+                singleThreadPositions.push_back(bodies.GetPosition(static_cast<unsigned int>(actorIndex)));
+            }
+        }
+        else
+        {
+            for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+            {
+                Vec3 const position = bodies.GetPosition(static_cast<unsigned int>(actorIndex));
+
+                if (position.x != singleThreadPositions[actorIndex].x ||
+                    position.y != singleThreadPositions[actorIndex].y ||
+                    position.z != singleThreadPositions[actorIndex].z)
+                {
+                    mismatchCount++;
+                }
+            }
+        }
+
+        String const report = Stringf("Jobs %d threads, %d actors x %d frames: %.3f ms/frame, %.2fx, %d steals last phase, %d mismatches",
+                                      threadCount, actorCount, frameCount,
+                                      seconds * 1000.0 / frameCount,
+                                      seconds > 0.0 ? singleThreadSeconds / seconds : 0.0,
+                                      jobSystem.GetLastStealCount(), mismatchCount);
+
+        DebuggerPrintf("%s\n", report.c_str());
+        DebugAddMessage(report, 10.f);
+    }
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------
+void JobSystem::WorkerThreadMain(int const queueIndex)
+{
+    while (!m_isQuitting)
+    {
+        if (TryRunJob(queueIndex)) continue;
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.wait(lock, [this] { return m_isQuitting || m_queuedJobCount > 0; });
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs one job from this thread's deque, or failing that one stolen from another. Returns false if every deque was empty.
+bool JobSystem::TryRunJob(int const queueIndex)
+{
+    Job job;
+
+    if (!TryPopJob(queueIndex, job) &&
+        !TryStealJob(queueIndex, job))
+    {
+        return false;
+    }
+
+    m_queuedJobCount--;
+    (*job.m_function)(job.m_chunkIndex, job.m_beginIndex, job.m_endIndex);
+    m_unfinishedJobCount--;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The owner takes its newest job.
+bool JobSystem::TryPopJob(int const queueIndex,
+                          Job&      out_job)
+{
+    JobQueue&                         queue = *m_queues[queueIndex];
+    std::lock_guard<std::mutex> const lock(queue.m_mutex);
+
+    if (queue.m_jobs.empty()) return false;
+
+    out_job = queue.m_jobs.back();
+    queue.m_jobs.pop_back();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A thief takes the oldest job of the first non-empty deque after its own.
+bool JobSystem::TryStealJob(int const thiefQueueIndex,
+                            Job&      out_job)
+{
+    int const queueCount = static_cast<int>(m_queues.size());
+
+    for (int offset = 1; offset < queueCount; ++offset)
+    {
+        JobQueue&                         queue = *m_queues[(thiefQueueIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> const lock(queue.m_mutex);
+
+        if (queue.m_jobs.empty()) continue;
+
+        out_job = queue.m_jobs.front();
+        queue.m_jobs.pop_front();
+        m_stealCount++;
+
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------------------------------------
+// JobSystem.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Fixed pool of worker threads with one job deque per thread. Queue 0 belongs to the thread that calls ParallelFor, which
+// works through its own jobs while it waits. A thread pops the newest job of its own deque and, once that is empty, steals
+// the oldest job of another deque. With no worker threads, ParallelFor runs every chunk inline, in order.
+// Chunk boundaries depend only on the item count and chunk size, never on which thread runs a chunk, so callers that keep one
+// output per chunk and merge them in chunk order get the same result on any number of threads.
+class JobSystem
+{
+public:
+    using ChunkFunction = std::function<void(int chunkIndex, int beginIndex, int endIndex)>;
+
+    explicit JobSystem(int workerThreadCount);
+    ~JobSystem();
+
+    JobSystem(JobSystem const& copy)             = delete;
+    JobSystem& operator=(JobSystem const& copy) = delete;
+
+    void ParallelFor(int itemCount, int chunkSize, ChunkFunction const& function);
+
+    int GetThreadCount() const;
+    int GetLastJobCount() const;
+    int GetLastStealCount() const;
+
+    static int GetChunkCount(int itemCount, int chunkSize);
+#if defined(GAME_BENCHMARKS)
+    static void RunBenchmark();
+#endif
+
+private:
+    struct Job
+    {
+        ChunkFunction const* m_function   = nullptr;
+        int                  m_chunkIndex = 0;
+        int                  m_beginIndex = 0;
+        int                  m_endIndex   = 0;
+    };
+
+    struct JobQueue
+    {
+        std::mutex      m_mutex;
+        std::deque<Job> m_jobs;
+    };
+
+    void WorkerThreadMain(int queueIndex);
+    bool TryRunJob(int queueIndex);
+    bool TryPopJob(int queueIndex, Job& out_job);
+    bool TryStealJob(int thiefQueueIndex, Job& out_job);
+
+    std::vector<std::thread>               m_workerThreads;
+    std::vector<std::unique_ptr<JobQueue>> m_queues;                        // Entry 0 is the calling thread's; entry i + 1 is worker i's.
+    std::mutex                             m_wakeMutex;
+    std::condition_variable                m_wakeCondition;                 // Idle workers sleep here until jobs are queued or the pool quits.
+    std::atomic<int>                       m_queuedJobCount     = 0;        // Jobs pushed and not yet taken, so idle workers know to look.
+    std::atomic<int>                       m_unfinishedJobCount = 0;        // Jobs of the current ParallelFor that have not returned yet.
+    std::atomic<int>                       m_stealCount         = 0;
+    std::atomic<bool>                      m_isQuitting         = false;
+    int                                    m_lastJobCount       = 0;
+    int                                    m_lastStealCount     = 0;
+};
@@ -14,6 +14,7 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Game/Definition/ActorDefinition.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/ViewFrustum.hpp"
 #include "Game/Gameplay/Actor.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Gameplay/Map.hpp"
@@ -60,6 +61,8 @@ void PlayerController::UpdateInput(float const deltaSeconds)
 {
     UNUSED(deltaSeconds)
 
+    m_moveIntent = Vec3::ZERO;
+
     switch (m_deviceType)
     {
     case eDeviceType::CONTROLLER:
@@ -181,6 +184,7 @@ void PlayerController::UpdateFromKeyboard(float deltaSeconds)
         possessedActorOrientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
 
         possessedActor->TurnInDirection(possessedActorOrientation);
+        possessedActor->m_previousOrientation = possessedActor->m_orientation;    // Turned between steps, so there is nothing to interpolate.
 
 
         if (g_theInput->WasKeyJustPressed(NUMCODE_1))
@@ -200,23 +204,23 @@ void PlayerController::UpdateFromKeyboard(float deltaSeconds)
 
         if (g_theInput->IsKeyDown(KEYCODE_W))
         {
-            possessedActor->MoveInDirection(forward, speed);
+            m_moveIntent += possessedActor->GetMoveForce(forward, speed);
             possessedActor->PlayAnimationByName("Walk");
         }
 
         if (g_theInput->IsKeyDown(KEYCODE_S))
         {
-            possessedActor->MoveInDirection(-forward, speed);
+            m_moveIntent += possessedActor->GetMoveForce(-forward, speed);
         }
 
         if (g_theInput->IsKeyDown(KEYCODE_A))
         {
-            possessedActor->MoveInDirection(left, speed);
+            m_moveIntent += possessedActor->GetMoveForce(left, speed);
         }
 
         if (g_theInput->IsKeyDown(KEYCODE_D))
         {
-            possessedActor->MoveInDirection(-left, speed);
+            m_moveIntent += possessedActor->GetMoveForce(-left, speed);
         }
     }
     else
@@ -288,6 +292,7 @@ if (!m_isCameraMode)
         possessActorOrientation.m_yawDegrees += -(rightStickPos * speed * rightStickMag * turnRate * deltaSeconds).x;
         possessActorOrientation.m_pitchDegrees += -(rightStickPos * speed * rightStickMag * turnRate * deltaSeconds).y;
         possessActor->TurnInDirection(possessActorOrientation);
+        possessActor->m_previousOrientation = possessActor->m_orientation;    // Turned between steps, so there is nothing to interpolate.
     }
 
     if (controller.IsButtonDown(XBOX_BUTTON_A))
@@ -302,7 +307,7 @@ if (!m_isCameraMode)
         // Combine X / Y stick input into one movement vector
         Vec3 moveDir = forward * leftStickPos.y + -left * leftStickPos.x;
         moveDir.z    = 0.f;
-        possessActor->MoveInDirection(moveDir.GetNormalized(), actorSpeed);
+        m_moveIntent += possessActor->GetMoveForce(moveDir.GetNormalized(), actorSpeed);
         possessActor->PlayAnimationByName("Walk");
     }
 
@@ -354,25 +359,29 @@ void PlayerController::UpdateWorldCamera()
         {
             // m_worldCamera->SetOrthoGraphicView(Vec2(-1, -1), Vec2(1, 1));
             // m_worldCamera->SetPerspectiveGraphicView(2.0f, possessedActor->m_definition->m_cameraFOV, 0.1f, 100.f);
-            m_worldCamera->SetPerspectiveGraphicView(2.0f, possessedActor->m_definition->m_cameraFOV, 0.1f, 100.f);
+            m_cameraFOV = possessedActor->m_definition->m_cameraFOV;
+            m_worldCamera->SetPerspectiveGraphicView(m_cameraAspect, m_cameraFOV, m_cameraNear, m_cameraFar);
             // Set the world camera to use the possessed actor's eye height and FOV.
-            m_position = Vec3(possessedActor->m_position.x, possessedActor->m_position.y, possessedActor->m_definition->m_eyeHeight);
+            Vec3 const actorRenderPosition = possessedActor->GetRenderPosition();
+            m_position = Vec3(actorRenderPosition.x, actorRenderPosition.y, possessedActor->m_definition->m_eyeHeight);
             // m_position += Vec3::X_BASIS;
             m_orientation = possessedActor->m_orientation;
         }
         else
         {
-            m_worldCamera->SetPerspectiveGraphicView(2.0f, possessedActor->m_definition->m_cameraFOV, 0.1f, 100.f);
+            m_cameraFOV = possessedActor->m_definition->m_cameraFOV;
+            m_worldCamera->SetPerspectiveGraphicView(m_cameraAspect, m_cameraFOV, m_cameraNear, m_cameraFar);
         }
     }
 
     if (possessedActor->m_isDead)
     {
-        Vec3  startPos      = possessedActor->m_position + Vec3(0.f, 0.f, possessedActor->m_definition->m_eyeHeight);
-        Vec3  endPos        = possessedActor->m_position;
+        Vec3  renderPos     = possessedActor->GetRenderPosition();
+        Vec3  startPos      = renderPos + Vec3(0.f, 0.f, possessedActor->m_definition->m_eyeHeight);
+        Vec3  endPos        = renderPos;
         float deathFraction = possessedActor->m_dead / possessedActor->m_definition->m_corpseLifetime;
         float interpolate   = Interpolate(startPos.z, endPos.z, deathFraction);
-        m_position          = Vec3(possessedActor->m_position.x, possessedActor->m_position.y, interpolate);
+        m_position          = Vec3(renderPos.x, renderPos.y, interpolate);
     }
 
     m_viewCamera->SetOrthoGraphicView(g_theGame->m_screenSpace.m_mins, g_theGame->m_screenSpace.m_maxs);
@@ -395,3 +404,10 @@ Mat44 PlayerController::GetModelToWorldTransform() const
 
     return m2w;
 }
+
+//----------------------------------------------------------------------------------------------------
+// The world camera is placed at m_position with m_orientation in UpdateWorldCamera.
+ViewFrustum PlayerController::GetWorldCameraFrustum() const
+{
+    return ViewFrustum::MakePerspective(m_position, m_orientation, m_cameraAspect, m_cameraFOV, m_cameraNear, m_cameraFar);
+}
@@ -13,6 +13,7 @@
 //----------------------------------------------------------------------------------------------------
 class Camera;
 class Game;
+struct ViewFrustum;
 
 enum class eDeviceType : int8_t
 {
@@ -40,13 +41,21 @@ public:
     eDeviceType SetInputDeviceType(eDeviceType newDeviceType);
     eDeviceType GetInputDeviceType() const;
     Mat44       GetModelToWorldTransform() const;
+    ViewFrustum GetWorldCameraFrustum() const;
 
     Vec3        m_position     = Vec3::ZERO;
     Vec3        m_velocity     = Vec3::ZERO;
+    Vec3        m_moveIntent   = Vec3::ZERO;       // Move force latched from this frame's input; the map applies it in every simulation step.
     EulerAngles m_orientation  = EulerAngles::ZERO;
     bool        m_isCameraMode = false;
     // Camera*     m_worldCamera  = nullptr;
     eDeviceType m_deviceType   = eDeviceType::KEYBOARD_AND_MOUSE;
     float         m_speed = 0.f;
     float m_turnRate = 0.f;
+
+    // World camera projection, kept here so culling uses the same frustum the camera renders with.
+    float m_cameraAspect = 2.f;
+    float m_cameraFOV    = 60.f;
+    float m_cameraNear   = 0.1f;
+    float m_cameraFar    = 100.f;
 };
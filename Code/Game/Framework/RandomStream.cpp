@@ -0,0 +1,87 @@
+//----------------------------------------------------------------------------------------------------
+// RandomStream.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/RandomStream.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+RandomStream::RandomStream(unsigned int const seed,
+                           unsigned int const streamKey,
+                           unsigned int const tick)
+{
+    Reset(seed, streamKey, tick);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RandomStream::Reset(unsigned int const seed,
+                         unsigned int const streamKey,
+                         unsigned int const tick)
+{
+    m_streamSeed = GetNoiseUint(static_cast<int>(streamKey), GetNoiseUint(static_cast<int>(tick), seed));
+    m_position   = 0;
+    m_tick       = tick;
+    m_isKeyed    = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool RandomStream::IsKeyedForTick(unsigned int const tick) const
+{
+    return m_isKeyed && m_tick == tick;
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned int RandomStream::RollRandomUnsignedInt()
+{
+    return GetNoiseUint(m_position++, m_streamSeed);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Modulo of a 32-bit draw; the bias is negligible for the small ranges gameplay asks for.
+int RandomStream::RollRandomIntInRange(int const minInclusive,
+                                       int const maxInclusive)
+{
+    if (maxInclusive <= minInclusive) return minInclusive;
+
+    unsigned int const rangeSize = static_cast<unsigned int>(maxInclusive - minInclusive) + 1u;
+
+    return minInclusive + static_cast<int>(RollRandomUnsignedInt() % rangeSize);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The top 24 bits, which a float holds exactly, scaled so both 0 and 1 can come up.
+float RandomStream::RollRandomFloatZeroToOne()
+{
+    return static_cast<float>(RollRandomUnsignedInt() >> 8) * (1.f / 16777215.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+float RandomStream::RollRandomFloatInRange(float const minInclusive,
+                                           float const maxInclusive)
+{
+    return minInclusive + (maxInclusive - minInclusive) * RollRandomFloatZeroToOne();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Squirrel Eiserloh's Squirrel3 bit noise.
+STATIC unsigned int RandomStream::GetNoiseUint(int const          position,
+                                               unsigned int const seed)
+{
+    unsigned int constexpr BIT_NOISE1 = 0x68e31da4u;
+    unsigned int constexpr BIT_NOISE2 = 0xb5297a4du;
+    unsigned int constexpr BIT_NOISE3 = 0x1b56c4e9u;
+
+    unsigned int mangledBits = static_cast<unsigned int>(position);
+
+    mangledBits *= BIT_NOISE1;
+    mangledBits += seed;
+    mangledBits ^= mangledBits >> 8;
+    mangledBits += BIT_NOISE2;
+    mangledBits ^= mangledBits << 8;
+    mangledBits *= BIT_NOISE3;
+    mangledBits ^= mangledBits >> 8;
+
+    return mangledBits;
+}
@@ -0,0 +1,34 @@
+//----------------------------------------------------------------------------------------------------
+// RandomStream.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+// Counter-based random numbers: the n-th draw is Squirrel3 noise of n, seeded by a hash of (seed, stream key, tick), so it
+// depends only on those keys and on how many draws the stream has made, never on draws made by other streams.
+// Each actor and the map own one stream, re-keyed every simulation tick, so draws are lock-free as long as one stream is only
+// used by one thread at a time, and the same for any schedule or thread count.
+class RandomStream
+{
+public:
+    RandomStream() = default;
+    RandomStream(unsigned int seed, unsigned int streamKey, unsigned int tick);
+
+    void Reset(unsigned int seed, unsigned int streamKey, unsigned int tick);
+    bool IsKeyedForTick(unsigned int tick) const;
+
+    unsigned int RollRandomUnsignedInt();
+    int          RollRandomIntInRange(int minInclusive, int maxInclusive);
+    float        RollRandomFloatZeroToOne();
+    float        RollRandomFloatInRange(float minInclusive, float maxInclusive);
+
+    static unsigned int GetNoiseUint(int position, unsigned int seed);
+
+private:
+    unsigned int m_streamSeed = 0;      // Hash of (seed, stream key, tick); the stream's counter is fed through noise seeded by it.
+    int          m_position   = 0;      // Draws made since the last Reset.
+    unsigned int m_tick       = 0;
+    bool         m_isKeyed    = false;
+};
@@ -0,0 +1,30 @@
+//----------------------------------------------------------------------------------------------------
+// RenderStats.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/RenderStats.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void RenderStats::BeginFrame()
+{
+    m_bytesUploadedLastFrame = m_bytesUploadedThisFrame;
+    m_drawCallsLastFrame     = m_drawCallsThisFrame;
+    m_bytesUploadedThisFrame = 0;
+    m_drawCallsThisFrame     = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderStats::AddUpload(size_t const byteCount)
+{
+    m_bytesUploadedThisFrame += byteCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// DrawVertexArray copies its vertexes to the GPU before drawing, so those call sites pass the array size.
+// Draws from buffers that were uploaded earlier pass nothing.
+void RenderStats::AddDrawCall(size_t const uploadedByteCount)
+{
+    m_bytesUploadedThisFrame += uploadedByteCount;
+    m_drawCallsThisFrame++;
+}
@@ -0,0 +1,23 @@
+//----------------------------------------------------------------------------------------------------
+// RenderStats.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+
+//----------------------------------------------------------------------------------------------------
+// Game-side counters for the traffic the game sends to the renderer.
+// The engine renderer does not report uploads, so every in-game draw and buffer upload records itself here.
+// This keeps the numbers available without a GPU or a graphics debugger.
+struct RenderStats
+{
+    void BeginFrame();
+    void AddUpload(size_t byteCount);
+    void AddDrawCall(size_t uploadedByteCount = 0);
+
+    size_t m_bytesUploadedThisFrame = 0;
+    int    m_drawCallsThisFrame     = 0;
+    size_t m_bytesUploadedLastFrame = 0;
+    int    m_drawCallsLastFrame     = 0;
+};
@@ -0,0 +1,205 @@
+//----------------------------------------------------------------------------------------------------
+// TaskGraph.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/TaskGraph.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int TaskGraph::AddTask(String const&           name,
+                       std::vector<int> const& dependencies,
+                       TaskFunction const&     function)
+{
+    Task task;
+    task.m_name     = name;
+    task.m_function = function;
+
+    return AddTask(task, dependencies);
+}
+
+//----------------------------------------------------------------------------------------------------
+// For work that must stay on the thread that owns input, audio and debug rendering, or that spawns and deletes actors.
+int TaskGraph::AddMainThreadTask(String const&           name,
+                                 std::vector<int> const& dependencies,
+                                 TaskFunction const&     function)
+{
+    Task task;
+    task.m_name             = name;
+    task.m_function         = function;
+    task.m_isMainThreadOnly = true;
+
+    return AddTask(task, dependencies);
+}
+
+//----------------------------------------------------------------------------------------------------
+int TaskGraph::AddParallelTask(String const&                   name,
+                               std::vector<int> const&         dependencies,
+                               ItemCountFunction const&        getItemCount,
+                               int const                       chunkSize,
+                               JobSystem::ChunkFunction const& function)
+{
+    Task task;
+    task.m_name          = name;
+    task.m_getItemCount  = getItemCount;
+    task.m_chunkFunction = function;
+    task.m_chunkSize     = chunkSize;
+
+    return AddTask(task, dependencies);
+}
+
+//----------------------------------------------------------------------------------------------------
+void TaskGraph::Execute(JobSystem& jobSystem,
+                        bool const isSerial)
+{
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    m_lastJobCount = 0;
+
+    if (isSerial)
+    {
+        for (Task const& task : m_tasks)
+        {
+            RunTaskInline(task);
+        }
+
+        m_lastExecuteSeconds = GetCurrentTimeSeconds() - startSeconds;
+        return;
+    }
+
+    for (int level = 0; level < m_levelCount; ++level)
+    {
+        // 1. Main thread tasks of this level, in insertion order.
+        for (Task const& task : m_tasks)
+        {
+            if (task.m_level == level && task.m_isMainThreadOnly)
+            {
+                task.m_function();
+            }
+        }
+
+        // 2. Every other task of this level becomes one job, or one job per chunk, in a single ParallelFor.
+        m_levelJobs.clear();
+
+        for (int taskIndex = 0; taskIndex < static_cast<int>(m_tasks.size()); ++taskIndex)
+        {
+            Task const& task = m_tasks[taskIndex];
+
+            if (task.m_level != level || task.m_isMainThreadOnly) continue;
+
+            if (!task.m_chunkFunction)
+            {
+                m_levelJobs.push_back(LevelJob{ taskIndex, 0, 0, 0 });
+                continue;
+            }
+
+            int const itemCount  = task.m_getItemCount();
+            int const chunkCount = JobSystem::GetChunkCount(itemCount, task.m_chunkSize);
+
+            for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+            {
+                int const beginIndex = chunkIndex * task.m_chunkSize;
+                int const endIndex   = beginIndex + task.m_chunkSize < itemCount ? beginIndex + task.m_chunkSize : itemCount;
+
+                m_levelJobs.push_back(LevelJob{ taskIndex, chunkIndex, beginIndex, endIndex });
+            }
+        }
+
+        m_lastJobCount += static_cast<int>(m_levelJobs.size());
+
+        jobSystem.ParallelFor(static_cast<int>(m_levelJobs.size()), 1, [this](int const jobIndex, int, int)
+        {
+            LevelJob const& job  = m_levelJobs[jobIndex];
+            Task const&     task = m_tasks[job.m_taskIndex];
+
+            if (task.m_chunkFunction)
+            {
+                task.m_chunkFunction(job.m_chunkIndex, job.m_beginIndex, job.m_endIndex);
+            }
+            else
+            {
+                task.m_function();
+            }
+        });
+    }
+
+    m_lastExecuteSeconds = GetCurrentTimeSeconds() - startSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TaskGraph::GetTaskCount() const
+{
+    return static_cast<int>(m_tasks.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int TaskGraph::GetLevelCount() const
+{
+    return m_levelCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TaskGraph::GetLastJobCount() const
+{
+    return m_lastJobCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+double TaskGraph::GetLastExecuteSeconds() const
+{
+    return m_lastExecuteSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TaskGraph::AddTask(Task const&             task,
+                       std::vector<int> const& dependencies)
+{
+    int const taskIndex = static_cast<int>(m_tasks.size());
+
+    m_tasks.push_back(task);
+
+    for (int const dependencyIndex : dependencies)
+    {
+        if (dependencyIndex < 0 || dependencyIndex >= taskIndex)
+        {
+            ERROR_AND_DIE(Stringf("Task \"%s\" depends on task %d, which was not added before it", task.m_name.c_str(), dependencyIndex))
+        }
+
+        int const dependencyLevel = m_tasks[dependencyIndex].m_level;
+
+        if (dependencyLevel + 1 > m_tasks[taskIndex].m_level)
+        {
+            m_tasks[taskIndex].m_level = dependencyLevel + 1;
+        }
+    }
+
+    if (m_tasks[taskIndex].m_level + 1 > m_levelCount)
+    {
+        m_levelCount = m_tasks[taskIndex].m_level + 1;
+    }
+
+    return taskIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TaskGraph::RunTaskInline(Task const& task) const
+{
+    if (!task.m_chunkFunction)
+    {
+        task.m_function();
+        return;
+    }
+
+    int const itemCount  = task.m_getItemCount();
+    int const chunkCount = JobSystem::GetChunkCount(itemCount, task.m_chunkSize);
+
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        int const beginIndex = chunkIndex * task.m_chunkSize;
+        int const endIndex   = beginIndex + task.m_chunkSize < itemCount ? beginIndex + task.m_chunkSize : itemCount;
+
+        task.m_chunkFunction(chunkIndex, beginIndex, endIndex);
+    }
+}
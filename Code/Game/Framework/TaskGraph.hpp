@@ -0,0 +1,65 @@
+//----------------------------------------------------------------------------------------------------
+// TaskGraph.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <functional>
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Framework/JobSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Fixed set of tasks with explicit dependencies, built once and executed every frame through the job system.
+// A task is either a single function, or a parallel task whose items are split into chunks like JobSystem::ParallelFor.
+// Dependencies must be added before the tasks that use them, so insertion order is always a valid serial order.
+// Execute runs the graph level by level, where a task's level is one more than its deepest dependency: main thread tasks of
+// the level run first on the calling thread, then every other task and chunk of the level share one ParallelFor.
+// In serial mode the tasks run one after another in insertion order, chunks in order, all on the calling thread.
+class TaskGraph
+{
+public:
+    using TaskFunction      = std::function<void()>;
+    using ItemCountFunction = std::function<int()>;
+
+    int AddTask(String const& name, std::vector<int> const& dependencies, TaskFunction const& function);
+    int AddMainThreadTask(String const& name, std::vector<int> const& dependencies, TaskFunction const& function);
+    int AddParallelTask(String const& name, std::vector<int> const& dependencies, ItemCountFunction const& getItemCount, int chunkSize, JobSystem::ChunkFunction const& function);
+
+    void Execute(JobSystem& jobSystem, bool isSerial);
+
+    int    GetTaskCount() const;
+    int    GetLevelCount() const;
+    int    GetLastJobCount() const;
+    double GetLastExecuteSeconds() const;
+
+private:
+    struct Task
+    {
+        String                   m_name;
+        TaskFunction             m_function;            // Single and main thread tasks.
+        ItemCountFunction        m_getItemCount;        // Parallel tasks; evaluated when the task's level starts.
+        JobSystem::ChunkFunction m_chunkFunction;
+        int                      m_chunkSize        = 0;
+        bool                     m_isMainThreadOnly = false;
+        int                      m_level            = 0;
+    };
+
+    struct LevelJob
+    {
+        int m_taskIndex  = 0;
+        int m_chunkIndex = 0;
+        int m_beginIndex = 0;
+        int m_endIndex   = 0;
+    };
+
+    int  AddTask(Task const& task, std::vector<int> const& dependencies);
+    void RunTaskInline(Task const& task) const;
+
+    std::vector<Task>     m_tasks;                      // In insertion order.
+    int                   m_levelCount         = 0;
+    std::vector<LevelJob> m_levelJobs;                  // Scratch list of the current level's jobs.
+    int                   m_lastJobCount       = 0;     // Jobs handed to the job system by the last Execute.
+    double                m_lastExecuteSeconds = 0.0;
+};
@@ -0,0 +1,75 @@
+//----------------------------------------------------------------------------------------------------
+// ViewFrustum.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ViewFrustum.hpp"
+
+#include <cmath>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Matches Camera::SetPerspectiveGraphicView: fovDegrees is the vertical field of view, aspect is width / height.
+STATIC ViewFrustum ViewFrustum::MakePerspective(Vec3 const&        position,
+                                                EulerAngles const& orientation,
+                                                float const        aspect,
+                                                float const        fovDegrees,
+                                                float const        zNear,
+                                                float const        zFar)
+{
+    Vec3 forward, left, up;
+    orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+
+    // The horizontal half angle comes from tan(h) = tan(v) * aspect.
+    float const sinVertical     = SinDegrees(fovDegrees * 0.5f);
+    float const cosVertical     = CosDegrees(fovDegrees * 0.5f);
+    float const tanHorizontal   = sinVertical / cosVertical * aspect;
+    float const cosHorizontal   = 1.f / sqrtf(1.f + tanHorizontal * tanHorizontal);
+    float const sinHorizontal   = tanHorizontal * cosHorizontal;
+    float const forwardDistance = DotProduct3D(forward, position);
+
+    ViewFrustum frustum;
+
+    frustum.m_planeNormals[0] = forward;
+    frustum.m_planeNormals[1] = -forward;
+    frustum.m_planeNormals[2] = forward * sinHorizontal - left * cosHorizontal;
+    frustum.m_planeNormals[3] = forward * sinHorizontal + left * cosHorizontal;
+    frustum.m_planeNormals[4] = forward * sinVertical - up * cosVertical;
+    frustum.m_planeNormals[5] = forward * sinVertical + up * cosVertical;
+
+    frustum.m_planeDistances[0] = forwardDistance + zNear;
+    frustum.m_planeDistances[1] = -(forwardDistance + zFar);
+
+    // The side planes all pass through the eye.
+    for (int planeIndex = 2; planeIndex < PLANE_COUNT; ++planeIndex)
+    {
+        frustum.m_planeDistances[planeIndex] = DotProduct3D(frustum.m_planeNormals[planeIndex], position);
+    }
+
+    return frustum;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Conservative test: the box is only reported outside when its corner furthest along a plane normal is behind that plane.
+// Boxes that straddle a frustum corner may be kept, which only costs a draw that was not needed.
+bool ViewFrustum::IsOutside(AABB3 const& bounds) const
+{
+    for (int planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex)
+    {
+        Vec3 const& normal        = m_planeNormals[planeIndex];
+        Vec3 const  furthestPoint = Vec3(normal.x >= 0.f ? bounds.m_maxs.x : bounds.m_mins.x,
+                                         normal.y >= 0.f ? bounds.m_maxs.y : bounds.m_mins.y,
+                                         normal.z >= 0.f ? bounds.m_maxs.z : bounds.m_mins.z);
+
+        if (DotProduct3D(normal, furthestPoint) < m_planeDistances[planeIndex])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,26 @@
+//----------------------------------------------------------------------------------------------------
+// ViewFrustum.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct AABB3;
+struct EulerAngles;
+
+//----------------------------------------------------------------------------------------------------
+// World-space perspective frustum, stored as six inward-facing planes (near, far, left, right, top, bottom).
+// A point p is inside a plane when DotProduct3D(normal, p) >= distance.
+struct ViewFrustum
+{
+    static ViewFrustum MakePerspective(Vec3 const& position, EulerAngles const& orientation, float aspect, float fovDegrees, float zNear, float zFar);
+
+    bool IsOutside(AABB3 const& bounds) const;
+
+    static constexpr int PLANE_COUNT = 6;
+
+    Vec3  m_planeNormals[PLANE_COUNT];
+    float m_planeDistances[PLANE_COUNT] = {};
+};
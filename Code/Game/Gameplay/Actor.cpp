@@ -10,7 +10,6 @@
 #include "Engine/Core/Timer.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
-#include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Game/Definition/ActorDefinition.hpp"
 #include "Game/Definition/MapDefinition.hpp"
@@ -19,10 +18,10 @@
 #include "Game/Framework/AnimationGroup.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Framework/PlayerController.hpp"
+#include "Game/Gameplay/BillboardBatcher.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Gameplay/Map.hpp"
 #include "Game/Gameplay/Sound.hpp"
-#include "Game/Gameplay/Tile.hpp"
 #include "Game/Gameplay/Weapon.hpp"
 
 //----------------------------------------------------------------------------------------------------
@@ -40,7 +39,7 @@ Actor::Actor(SpawnInfo const& spawnInfo)
     m_radius      = m_definition->m_radius;
     m_position    = spawnInfo.m_position;
     m_orientation = spawnInfo.m_orientation;
-    m_velocity    = spawnInfo.m_velocity;
+    SnapPreviousTransform();
 
     for (String const& weapon : m_definition->m_inventory)
     {
@@ -75,6 +74,23 @@ Actor::Actor(SpawnInfo const& spawnInfo)
     m_animationTimer = new Timer(0, g_theGame->m_gameClock);
 }
 
+//----------------------------------------------------------------------------------------------------
+// Actors are destroyed and their slots reused constantly, so everything the actor allocated is released here.
+Actor::~Actor()
+{
+    for (Weapon*& weapon : m_weapons)
+    {
+        SafeDeletePointer(weapon);
+    }
+
+    m_weapons.clear();
+    m_currentWeapon = nullptr;
+    m_controller    = nullptr;
+
+    SafeDeletePointer(m_aiController);
+    SafeDeletePointer(m_animationTimer);
+}
+
 //----------------------------------------------------------------------------------------------------
 void Actor::Update(float const deltaSeconds)
 {
@@ -100,27 +116,28 @@ void Actor::Update(float const deltaSeconds)
         m_isGarbage = true;
     }
 
-    if (!m_isDead)
-    {
-        UpdatePhysics(deltaSeconds);
-    }
+    m_collisionCylinder.m_startPosition = m_position;
+    m_collisionCylinder.m_endPosition   = m_position + Vec3(0.f, 0.f, m_height);
+    m_map->UpdateActorCylinder(*this);
+    m_map->UpdateActorBody(*this);
+}
 
+//----------------------------------------------------------------------------------------------------
+// Steering for actors driven by their own AI, run by Map in the parallel actor update phase before the serial Update.
+void Actor::UpdateAI(float const         deltaSeconds,
+                     ActorCommandBuffer* commands)
+{
     if (m_aiController != nullptr && m_definition->m_aiEnabled && dynamic_cast<PlayerController*>(m_controller) == nullptr)
     {
-        m_aiController->Update(deltaSeconds);
+        m_aiController->UpdateSteering(deltaSeconds, commands);
     }
-
-    m_collisionCylinder.m_startPosition = m_position;
-    m_collisionCylinder.m_endPosition   = m_position + Vec3(0.f, 0.f, m_height);
 }
 
 //----------------------------------------------------------------------------------------------------
-// If visible, we will need vertexes and any other information necessary for rendering.
-void Actor::Render(PlayerController const* toPlayer) const
+// If visible, pick the sprite for the current animation and viewing direction and hand it to the view's batcher.
+void Actor::Render(PlayerController const* toPlayer,
+                   BillboardBatcher&       batcher) const
 {
-    // if (m_definition->m_name == "SpawnPoint") return;
-    // if (!m_isVisible) return;
-
     if (!m_definition->m_isVisible) return; // Check if visible. If not, return.
     if (m_controller && dynamic_cast<PlayerController*>(m_controller)) // Check if we are the rendering player and not in free fly mode. If so, return.
     {
@@ -131,77 +148,34 @@ void Actor::Render(PlayerController const* toPlayer) const
             return ;
     }
 
+    // Rendering runs between simulation steps, so draw the actor between where the last step started and ended.
+    Vec3 const renderPosition = GetRenderPosition();
+    Mat44      renderModelToWorld;
+
+    renderModelToWorld.SetTranslation3D(renderPosition);
+    renderModelToWorld.Append(GetRenderOrientation().GetAsMatrix_IFwd_JLeft_KUp());
+
     Mat44 localToWorldMat;
     Vec3  eyeHeight = Vec3(0.f, 0.f, m_definition->m_eyeHeight);
-    // if (m_definition->m_billboardType == eBillboardType::NONE)localToWorldMat = GetModelToWorldTransform();
-    // if (m_definition->m_billboardType == eBillboardType::WORLD_UP_FACING)localToWorldMat.Append(GetBillboardMatrix(eBillboardType::WORLD_UP_FACING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position));
-    // if (m_definition->m_billboardType == eBillboardType::FULL_OPPOSING)localToWorldMat.Append(GetBillboardMatrix(eBillboardType::FULL_OPPOSING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position));
-    // if (m_definition->m_billboardType == eBillboardType::WORLD_UP_OPPOSING)localToWorldMat.Append(GetBillboardMatrix(eBillboardType::WORLD_UP_OPPOSING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position));
-    if (m_definition->m_billboardType == eBillboardType::NONE)
-    {
-        localToWorldMat = GetModelToWorldTransform();
-    }
-    else
-    {
-        if (m_definition->m_billboardType == eBillboardType::WORLD_UP_FACING)
-        {
-            // Mat44 cameraTransform = Mat44::MakeTranslation3D(toPlayer->m_position);
-            // cameraTransform.Append(toPlayer->m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
-            // localToWorldMat = Mat44::MakeTranslation3D(m_position);
-            localToWorldMat.Append(GetBillboardMatrix(eBillboardType::WORLD_UP_FACING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position));
-        }
-        else if (m_definition->m_billboardType == eBillboardType::FULL_OPPOSING)
-        {
-            // Mat44 cameraTransform = Mat44::MakeTranslation3D(toPlayer->m_position);
-            // cameraTransform.Append(toPlayer->m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
-            localToWorldMat.Append(GetBillboardMatrix(eBillboardType::FULL_OPPOSING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position));
-        }
-        else if (m_definition->m_billboardType == eBillboardType::WORLD_UP_OPPOSING)
-        {
-            // Mat44 cameraTransform = Mat44::MakeTranslation3D(toPlayer->m_position);
-            // cameraTransform.Append(toPlayer->m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
-            localToWorldMat.Append(GetBillboardMatrix(eBillboardType::WORLD_UP_OPPOSING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position + eyeHeight));
-        }
-        else
-        {
-            localToWorldMat = GetModelToWorldTransform();
-        }
-    }
-
-    // verts.reserve(8192);
-    // float const eyeHeight         = m_definition->m_eyeHeight;
-    Vec3 const forwardNormal   = m_orientation.GetAsMatrix_IFwd_JLeft_KUp().GetIBasis3D().GetNormalized();
-    Vec3 const forwardNormalXY = Vec3(forwardNormal.x, forwardNormal.y, 0.f).GetNormalized();
-    // Vec3 const  coneStartPosition = m_collisionCylinder.m_startPosition + Vec3(0.f, 0.f, eyeHeight) + forwardNormalXY * m_collisionCylinder.m_radius;
 
-    if (m_definition->m_name != "PlasmaProjectile")
+    if (m_definition->m_billboardType == eBillboardType::WORLD_UP_FACING ||
+        m_definition->m_billboardType == eBillboardType::FULL_OPPOSING)
     {
-        if (m_isDead)
-        {
-            // AddVertsForCone3D(verts, coneStartPosition, coneStartPosition + forwardNormalXY * 0.1f, 0.1f, Interpolate(m_color, Rgba8::BLACK, 0.5f));
-        }
-        else
-        {
-            // AddVertsForCone3D(verts, coneStartPosition, coneStartPosition + forwardNormalXY * 0.1f, 0.1f, m_color);
-        }
-
-        // AddVertsForWireframeCone3D(verts, coneStartPosition, coneStartPosition + forwardNormalXY * 0.1f, 0.1f, 0.001f);
+        localToWorldMat = batcher.GetBillboardTransform(m_definition->m_billboardType, renderPosition);
     }
-
-    if (m_isDead)
+    else if (m_definition->m_billboardType == eBillboardType::WORLD_UP_OPPOSING)
     {
-        // AddVertsForCylinder3D(verts, m_collisionCylinder.m_startPosition, m_collisionCylinder.m_endPosition, m_collisionCylinder.m_radius, Interpolate(m_color, Rgba8::BLACK, 0.5f));
+        localToWorldMat = batcher.GetBillboardTransform(m_definition->m_billboardType, renderPosition + eyeHeight);
     }
     else
     {
-        // AddVertsForCylinder3D(verts, m_collisionCylinder.m_startPosition, m_collisionCylinder.m_endPosition, m_collisionCylinder.m_radius, m_color);
+        localToWorldMat = renderModelToWorld;
     }
-    // AddVertsForWireframeCylinder3D(verts, m_collisionCylinder.m_startPosition, m_collisionCylinder.m_endPosition, m_collisionCylinder.m_radius, 0.001f);
 
     /// Get facing sprite UVs.
-    Vec2 dirCameraToActorXY = Vec2(m_position.x - toPlayer->m_position.x, m_position.y - toPlayer->m_position.y).GetNormalized();
+    Vec2 dirCameraToActorXY = Vec2(renderPosition.x - toPlayer->m_position.x, renderPosition.y - toPlayer->m_position.y).GetNormalized();
     Vec3 dirCameraToActor   = Vec3(dirCameraToActorXY.x, dirCameraToActorXY.y, 0.f).GetNormalized();
-    Vec3 viewingDirection   = GetModelToWorldTransform().GetOrthonormalInverse().TransformVectorQuantity3D(dirCameraToActor);
+    Vec3 viewingDirection   = renderModelToWorld.GetOrthonormalInverse().TransformVectorQuantity3D(dirCameraToActor);
 
     AnimationGroup const* animationGroup = m_currentPlayingAnimationGroup;
     if (animationGroup == nullptr && (int)m_definition->m_animationGroup.size() > 0) // We use the index 0 animation group
@@ -214,137 +188,7 @@ void Actor::Render(PlayerController const* toPlayer) const
     SpriteDefinition const spriteAtTime = anim->GetSpriteDefAtTime(m_animationTimer->GetElapsedTime() * 1); // TODO: Handle animation speed.
     AABB2                  uvAtTime     = spriteAtTime.GetUVs();
 
-    Vec2 spriteOffSet = -m_definition->m_size * m_definition->m_pivot;
-    Vec3 bottomLeft   = Vec3(0.f, spriteOffSet.x, spriteOffSet.y);
-    Vec3 bottomRight  = bottomLeft + Vec3(0.f, m_definition->m_size.x, 0.f);
-    Vec3 topLeft      = bottomLeft + Vec3(0.f, 0.f, m_definition->m_size.y);
-    Vec3 topRight     = bottomRight + Vec3(0.f, 0.f, m_definition->m_size.y);
-
-    bool const        bIsLit = m_definition->m_renderLit;
-    VertexList_PCU    unlitVerts;
-    VertexList_PCUTBN litVerts;
-
-    if (bIsLit)
-    {
-        if (m_definition->m_renderRounded)
-        {
-            litVerts.reserve(12000);
-            AddVertsForRoundedQuad3D(litVerts, topRight, bottomRight, bottomLeft, topLeft, Rgba8::WHITE, uvAtTime);
-            g_theRenderer->SetModelConstants(localToWorldMat, Rgba8::WHITE);
-            g_theRenderer->SetLightConstants(m_map->m_sunDirection, m_map->m_sunIntensity, m_map->m_ambientIntensity);
-            g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-            g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-            g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-            g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-            g_theRenderer->BindShader(m_definition->m_shader);
-            g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-            g_theRenderer->DrawVertexArray(litVerts);
-            return;
-        }
-
-        litVerts.reserve(12000);
-        AddVertsForQuad3D(litVerts, bottomLeft, bottomRight, topLeft, topRight, Rgba8::WHITE, uvAtTime);
-        g_theRenderer->SetModelConstants(localToWorldMat, Rgba8::WHITE);
-        g_theRenderer->SetLightConstants(m_map->m_sunDirection, m_map->m_sunIntensity, m_map->m_ambientIntensity);
-        g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-        g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-        g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-        g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-        g_theRenderer->BindShader(m_definition->m_shader);
-        g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-        g_theRenderer->DrawVertexArray(litVerts);
-        return;
-    }
-    else
-    {
-        if (m_definition->m_renderRounded)
-        {
-            // unlitVerts.reserve(12000);
-            // AddVertsForRoundedQuad3D(litVerts, topRight, bottomRight, bottomLeft, topLeft, Rgba8::WHITE, uvAtTime);
-            // g_theRenderer->SetModelConstants(localToWorldMat, Rgba8::WHITE);
-            // g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-            // g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-            // g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_NONE);
-            // // g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-            // g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-            // g_theRenderer->BindShader(m_definition->m_shader);
-            // g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-            // g_theRenderer->DrawVertexArray(unlitVerts);
-            return;
-        }
-        else
-        {
-            unlitVerts.reserve(12000);
-            AddVertsForQuad3D(unlitVerts, bottomLeft, bottomRight, topLeft, topRight, Rgba8::WHITE, uvAtTime);
-            g_theRenderer->SetModelConstants(localToWorldMat, Rgba8::WHITE);
-            g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-            g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-            g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_NONE);
-            // g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-            g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-            g_theRenderer->BindShader(m_definition->m_shader);
-            g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-            g_theRenderer->DrawVertexArray(unlitVerts);
-            return;
-        }
-    }
-
-
-    // bool const bIsLit = m_definition->m_renderLit;
-    // bool const renderRounded = m_definition->m_renderRounded;
-    //
-    // VertexList_PCUTBN litVerts;
-    // VertexList_PCU    unlitVerts;
-    //
-    // Rgba8 const color = Rgba8::WHITE;
-    //
-    // if (bIsLit)
-    // {
-    //     litVerts.reserve(12000);
-    //
-    //     if (renderRounded)
-    //     {
-    //         AddVertsForRoundedQuad3D(litVerts, topRight, bottomRight, bottomLeft, topLeft, color, uvAtTime);
-    //     }
-    //     else
-    //     {
-    //         AddVertsForQuad3D(unlitVerts, bottomLeft, bottomRight, topLeft, topRight, color, uvAtTime);
-    //     }
-    //
-    //     g_theRenderer->SetModelConstants(localToWorldMat, color);
-    //     g_theRenderer->SetLightConstants(m_map->m_sunDirection, m_map->m_sunIntensity, m_map->m_ambientIntensity);
-    //     g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-    //     g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-    //     g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-    //     g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-    //     g_theRenderer->BindShader(m_definition->m_shader);
-    //     g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-    //     g_theRenderer->DrawVertexArray(renderRounded ? litVerts : litVerts); // always litVerts in lit path
-    //     return;
-    // }
-    // else
-    // {
-    //     unlitVerts.reserve(12000);
-    //
-    //     if (renderRounded)
-    //     {
-    //         AddVertsForRoundedQuad3D(unlitVerts, topRight, bottomRight, bottomLeft, topLeft, color, uvAtTime);
-    //     }
-    //     else
-    //     {
-    //         AddVertsForQuad3D(unlitVerts, bottomLeft, bottomRight, topLeft, topRight, color, uvAtTime);
-    //     }
-    //
-    //     g_theRenderer->SetModelConstants(localToWorldMat, color);
-    //     g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-    //     g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-    //     g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-    //     g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-    //     g_theRenderer->BindShader(m_definition->m_shader);
-    //     g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-    //     g_theRenderer->DrawVertexArray(unlitVerts);
-    //     return;
-    // }
+    batcher.AddSprite(*m_definition, spriteAtTime.GetTexture(), uvAtTime, localToWorldMat);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -359,25 +203,39 @@ Mat44 Actor::GetModelToWorldTransform() const
 }
 
 //----------------------------------------------------------------------------------------------------
-void Actor::UpdatePhysics(float const deltaSeconds)
+// Keyed by the map seed, this actor's handle and the map tick, so the draws of one actor in one tick are the same whichever
+// thread makes them and whatever other actors drew first. Only use it from the thread that is updating this actor.
+RandomStream& Actor::GetRandomStream()
 {
-    float const dragValue = m_definition->m_drag;
-    Vec3 const  dragForce = -m_velocity * dragValue;
-    AddForce(dragForce);
+    unsigned int const tickIndex = m_map->GetTickIndex();
 
-    m_velocity += m_acceleration * deltaSeconds;
-    m_position += m_velocity * deltaSeconds;
-
-    if (!m_definition->m_flying)
+    if (!m_randomStream.IsKeyedForTick(tickIndex))
     {
-        if (m_definition->m_name != "BulletHit" &&
-            m_definition->m_name != "BloodSplatter")
-        {
-            m_position.z = 0.f;
-        }
+        unsigned int const streamKey = m_handle.GetGeneration() << 16 | m_handle.GetIndex();
+
+        m_randomStream.Reset(m_map->GetRandomSeed(), streamKey, tickIndex);
     }
 
-    m_acceleration = Vec3::ZERO;
+    return m_randomStream;
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 Actor::GetRenderPosition() const
+{
+    float const fraction = m_map->GetInterpolationFraction();
+
+    return m_previousPosition + (m_position - m_previousPosition) * fraction;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each angle turns the short way round, so a yaw crossing 180 does not spin through 0.
+EulerAngles Actor::GetRenderOrientation() const
+{
+    float const fraction = m_map->GetInterpolationFraction();
+
+    return EulerAngles(m_previousOrientation.m_yawDegrees + GetShortestAngularDispDegrees(m_previousOrientation.m_yawDegrees, m_orientation.m_yawDegrees) * fraction,
+                       m_previousOrientation.m_pitchDegrees + GetShortestAngularDispDegrees(m_previousOrientation.m_pitchDegrees, m_orientation.m_pitchDegrees) * fraction,
+                       m_previousOrientation.m_rollDegrees + GetShortestAngularDispDegrees(m_previousOrientation.m_rollDegrees, m_orientation.m_rollDegrees) * fraction);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -394,7 +252,7 @@ void Actor::UpdateAnimation(float const deltaSeconds)
 
     if (m_definition->m_runSpeed != 0.f)
     {
-        m_animationTimerSpeedMultiplier = m_velocity.GetLength() / m_definition->m_runSpeed;
+        m_animationTimerSpeedMultiplier = m_map->GetActorVelocity(m_handle).GetLength() / m_definition->m_runSpeed;
     }
 }
 
@@ -407,6 +265,7 @@ void Actor::Damage(int const          damage,
     if (m_health < 0)
     {
         m_isDead = true;
+        m_map->UpdateActorBody(*this);
     }
 
     if (m_aiController != nullptr)
@@ -437,21 +296,29 @@ void Actor::Damage(int const          damage,
 
 void Actor::AddForce(Vec3 const& force)
 {
-    m_acceleration += force;
+    m_map->AddActorForce(m_handle, force);
 }
 
 void Actor::AddImpulse(Vec3 const& impulse)
 {
-    m_velocity += impulse;
+    m_map->AddActorImpulse(m_handle, impulse);
 }
 
 void Actor::MoveInDirection(Vec3 const& direction,
                             float const speed)
+{
+    AddForce(GetMoveForce(direction, speed));
+}
+
+//----------------------------------------------------------------------------------------------------
+// The force that, against the actor's drag, settles at speed along direction.
+Vec3 Actor::GetMoveForce(Vec3 const& direction,
+                         float const speed) const
 {
     Vec3 const  directionNormal = direction.GetNormalized();
     float const dragValue       = m_definition->m_drag;
-    Vec3 const  force           = directionNormal * speed * dragValue;
-    AddForce(force);
+
+    return directionNormal * speed * dragValue;
 }
 
 void Actor::TurnInDirection(EulerAngles const& direction)
@@ -459,6 +326,14 @@ void Actor::TurnInDirection(EulerAngles const& direction)
     m_orientation = direction;
 }
 
+//----------------------------------------------------------------------------------------------------
+// For transforms set outside a simulation step (spawns, respawns, input), which have no earlier pose to interpolate from.
+void Actor::SnapPreviousTransform()
+{
+    m_previousPosition    = m_position;
+    m_previousOrientation = m_orientation;
+}
+
 //----------------------------------------------------------------------------------------------------
 void Actor::OnPossessed(Controller* controller)
 {
@@ -494,7 +369,7 @@ void Actor::OnCollisionEnterWithActor(Actor* other)
         if (m_owner&& !other->m_owner)
         {
             if (m_owner==other)return;
-            int randomDamage = (int)g_theRNG->RollRandomFloatInRange(m_definition->m_damageOnCollide.m_min, m_definition->m_damageOnCollide.m_max);
+            int randomDamage = (int)GetRandomStream().RollRandomFloatInRange(m_definition->m_damageOnCollide.m_min, m_definition->m_damageOnCollide.m_max);
             other->Damage(randomDamage, m_owner->m_handle);
             Vec3 forward, left, right;
             m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, right);
@@ -508,7 +383,7 @@ void Actor::OnCollisionEnterWithActor(Actor* other)
             {
                 return;
             }
-            int randomDamage = (int)g_theRNG->RollRandomFloatInRange(other->m_definition->m_damageOnCollide.m_min, other->m_definition->m_damageOnCollide.m_max);
+            int randomDamage = (int)GetRandomStream().RollRandomFloatInRange(other->m_definition->m_damageOnCollide.m_min, other->m_definition->m_damageOnCollide.m_max);
             Damage(randomDamage, other->m_handle);
             Vec3 forward, left, right;
             other->m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, right);
@@ -536,7 +411,7 @@ void Actor::OnCollisionEnterWithMap(IntVec2 const& tileCoords)
 {
     // TODO: Swap check method for Sprinting if needed (PushCapsuleOutOfAABB2D/DoCapsuleAndAABB2Overlap2D)
 
-    AABB3 const aabb3Box = m_map->GetTile(tileCoords.x, tileCoords.y)->m_bounds;
+    AABB3 const aabb3Box = m_map->GetTileBounds(tileCoords);
     AABB2 const aabb2Box = AABB2(Vec2(aabb3Box.m_mins.x, aabb3Box.m_mins.y), Vec2(aabb3Box.m_maxs.x, aabb3Box.m_maxs.y));
 
     Vec2 actorPositionXY = Vec2(m_position.x, m_position.y);
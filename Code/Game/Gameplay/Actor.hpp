@@ -14,11 +14,14 @@
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Game/Framework/ActorHandle.hpp"
+#include "Game/Framework/RandomStream.hpp"
 #include "Game/Gameplay/Sound.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class AIController;
+class ActorCommandBuffer;
 class AnimationGroup;
+class BillboardBatcher;
 class Controller;
 class PlayerController;
 class Texture;
@@ -35,18 +38,23 @@ class Actor
 
 public:
     explicit Actor(SpawnInfo const& spawnInfo);
+    ~Actor();
 
-    void  Update(float deltaSeconds);
-    void  Render(PlayerController const* toPlayer) const;
-    Mat44 GetModelToWorldTransform() const;
+    void        Update(float deltaSeconds);
+    void        UpdateAI(float deltaSeconds, ActorCommandBuffer* commands);
+    void        Render(PlayerController const* toPlayer, BillboardBatcher& batcher) const;
+    Mat44       GetModelToWorldTransform() const;
+    Vec3        GetRenderPosition() const;
+    EulerAngles GetRenderOrientation() const;
 
-    void UpdatePhysics(float deltaSeconds);
     void UpdateAnimation(float deltaSeconds);
     void Damage(int damage, ActorHandle const& other);
     void AddForce(Vec3 const& force);
     void AddImpulse(Vec3 const& impulse);
     void MoveInDirection(Vec3 const& direction, float speed);
+    Vec3 GetMoveForce(Vec3 const& direction, float speed) const;
     void TurnInDirection(EulerAngles const& direction);
+    void SnapPreviousTransform();
 
     // Possession
     void OnPossessed(Controller* controller);
@@ -60,6 +68,7 @@ public:
     void Attack() const;
     void SwitchInventory(unsigned int index);
     Vec3 GetActorEyePosition() const;
+    RandomStream& GetRandomStream();
 
     AnimationGroup* PlayAnimationByName(String const& animationName, bool force = false);
 
@@ -69,11 +78,11 @@ public:
     Actor*           m_owner      = nullptr;
 
     // bool        m_isVisible    = true;
-    bool        m_isStatic     = false;
-    Vec3        m_position     = Vec3::ZERO;               // 3D position, as a Vec3, in world units.
-    Vec3        m_velocity     = Vec3::ZERO;               // 3D velocity, as a Vec3, in world units per second.
-    Vec3        m_acceleration = Vec3::ZERO;                // 3D acceleration, as a Vec3, in world units per second squared.
-    EulerAngles m_orientation  = EulerAngles::ZERO;        // 3D orientation, as EulerAngles, in degrees.
+    bool        m_isStatic            = false;
+    Vec3        m_position            = Vec3::ZERO;            // 3D position, as a Vec3, in world units. Velocity and forces live in the map's ActorBodySet.
+    EulerAngles m_orientation         = EulerAngles::ZERO;     // 3D orientation, as EulerAngles, in degrees.
+    Vec3        m_previousPosition    = Vec3::ZERO;            // m_position before the last simulation step, for render interpolation.
+    EulerAngles m_previousOrientation = EulerAngles::ZERO;     // m_orientation before the last simulation step.
 
     float                m_radius            = 0.f;
     float                m_height            = 0.f;
@@ -102,4 +111,5 @@ public:
     // in which case he pushes the AI out of the way until he releases possession.
     AIController*                      m_aiController = nullptr;    // AI controllers should be constructed by the actor when the actor is spawned and immediately possess that actor.
     std::map<SoundID, SoundPlaybackID> m_soundPlaybackIDs;
+    RandomStream                       m_randomStream;    // Every random draw made on behalf of this actor; see GetRandomStream.
 };
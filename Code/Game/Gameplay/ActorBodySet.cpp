@@ -0,0 +1,393 @@
+//----------------------------------------------------------------------------------------------------
+// ActorBodySet.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/ActorBodySet.hpp"
+
+#include <emmintrin.h>
+#include <utility>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#include "Game/Framework/GameCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Writes a freshly spawned actor's body, growing the arrays (padded to a multiple of LANE_COUNT) when the slot is past the end.
+void ActorBodySet::AddBody(unsigned int const slotIndex,
+                           Vec3 const&        position,
+                           Vec3 const&        velocity,
+                           float const        radius,
+                           float const        height,
+                           float const        drag,
+                           uint8_t const      flags)
+{
+    if (slotIndex >= m_flags.size())
+    {
+        size_t const oldSlotCount = m_flags.size();
+        size_t const slotCount    = (static_cast<size_t>(slotIndex) + LANE_COUNT) / LANE_COUNT * LANE_COUNT;
+
+        m_positionXs.resize(slotCount);
+        m_positionYs.resize(slotCount);
+        m_positionZs.resize(slotCount);
+        m_velocityXs.resize(slotCount);
+        m_velocityYs.resize(slotCount);
+        m_velocityZs.resize(slotCount);
+        m_accelerationXs.resize(slotCount);
+        m_accelerationYs.resize(slotCount);
+        m_accelerationZs.resize(slotCount);
+        m_radii.resize(slotCount);
+        m_heights.resize(slotCount);
+        m_drags.resize(slotCount);
+        m_flags.resize(slotCount);
+
+        for (size_t entryIndex = oldSlotCount; entryIndex < slotCount; ++entryIndex)
+        {
+            ClearEntry(static_cast<unsigned int>(entryIndex));
+        }
+    }
+
+    ClearEntry(slotIndex);
+
+    m_positionXs[slotIndex] = position.x;
+    m_positionYs[slotIndex] = position.y;
+    m_positionZs[slotIndex] = position.z;
+    m_velocityXs[slotIndex] = velocity.x;
+    m_velocityYs[slotIndex] = velocity.y;
+    m_velocityZs[slotIndex] = velocity.z;
+    m_radii[slotIndex]      = radius;
+    m_heights[slotIndex]    = height;
+    m_drags[slotIndex]      = drag;
+    m_flags[slotIndex]      = flags | BODY_ACTIVE;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorBodySet::RemoveBody(unsigned int const slotIndex)
+{
+    if (slotIndex >= m_flags.size()) return;
+
+    ClearEntry(slotIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same steps as the per-actor update it replaces, four bodies at a time: drag is added to the accumulated forces, velocity then
+// position are advanced, pinned bodies drop back to the floor, and the forces are cleared. Bodies that are not simulated step
+// by zero, which leaves them exactly where they were. The lanes do the same single precision operations in the same order as
+// the scalar update, so the results match it exactly.
+void ActorBodySet::Integrate(float const deltaSeconds)
+{
+    IntegrateRange(deltaSeconds, 0, GetSlotCount());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Integrates slots [beginSlotIndex, endSlotIndex), widened outward to whole blocks of LANE_COUNT. Ranges that do not share a
+// block touch disjoint memory, so they can run on different threads.
+void ActorBodySet::IntegrateRange(float const deltaSeconds,
+                                  int const   beginSlotIndex,
+                                  int const   endSlotIndex)
+{
+    int const    firstBlockStart = beginSlotIndex / LANE_COUNT * LANE_COUNT;
+    int const    endBlockStart   = (endSlotIndex + LANE_COUNT - 1) / LANE_COUNT * LANE_COUNT;
+    int const    paddedCount     = endBlockStart < GetSlotCount() ? endBlockStart : GetSlotCount();
+    __m128 const zeros           = _mm_setzero_ps();
+    __m128 const ones            = _mm_set1_ps(1.f);
+    __m128 const steps           = _mm_set1_ps(deltaSeconds);
+
+    auto const getLaneMask = [this](int const blockStart, uint8_t const flag)
+    {
+        uint8_t const* const flags = &m_flags[blockStart];
+
+        return _mm_castsi128_ps(_mm_set_epi32((flags[3] & flag) != 0 ? -1 : 0, (flags[2] & flag) != 0 ? -1 : 0,
+                                              (flags[1] & flag) != 0 ? -1 : 0, (flags[0] & flag) != 0 ? -1 : 0));
+    };
+
+    auto const integrateAxis = [&zeros](float* const positions, float* const velocities, float* const accelerations,
+                                        __m128 const drags, __m128 const laneSteps, __m128 const positionScales)
+    {
+        __m128 const velocityValues     = _mm_loadu_ps(velocities);
+        __m128 const accelerationValues = _mm_add_ps(_mm_loadu_ps(accelerations), _mm_mul_ps(_mm_sub_ps(zeros, velocityValues), drags));
+        __m128 const newVelocityValues  = _mm_add_ps(velocityValues, _mm_mul_ps(accelerationValues, laneSteps));
+        __m128 const newPositionValues  = _mm_add_ps(_mm_loadu_ps(positions), _mm_mul_ps(newVelocityValues, laneSteps));
+
+        _mm_storeu_ps(velocities, newVelocityValues);
+        _mm_storeu_ps(positions, _mm_mul_ps(newPositionValues, positionScales));
+        _mm_storeu_ps(accelerations, zeros);
+    };
+
+    for (int blockStart = firstBlockStart; blockStart < paddedCount; blockStart += LANE_COUNT)
+    {
+        // 1. Per lane step, and a z scale of zero for simulated bodies pinned to the floor.
+        __m128 const simulated   = getLaneMask(blockStart, BODY_SIMULATED);
+        __m128 const pinned      = getLaneMask(blockStart, BODY_PINNED_TO_FLOOR);
+        __m128 const laneSteps   = _mm_and_ps(simulated, steps);
+        __m128 const floorScales = _mm_andnot_ps(_mm_and_ps(simulated, pinned), ones);
+        __m128 const drags       = _mm_loadu_ps(&m_drags[blockStart]);
+
+        // 2. Advance each axis.
+        integrateAxis(&m_positionXs[blockStart], &m_velocityXs[blockStart], &m_accelerationXs[blockStart], drags, laneSteps, ones);
+        integrateAxis(&m_positionYs[blockStart], &m_velocityYs[blockStart], &m_accelerationYs[blockStart], drags, laneSteps, ones);
+        integrateAxis(&m_positionZs[blockStart], &m_velocityZs[blockStart], &m_accelerationZs[blockStart], drags, laneSteps, floorScales);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorBodySet::AddForce(unsigned int const slotIndex,
+                            Vec3 const&        force)
+{
+    if (slotIndex >= m_flags.size()) return;
+
+    m_accelerationXs[slotIndex] += force.x;
+    m_accelerationYs[slotIndex] += force.y;
+    m_accelerationZs[slotIndex] += force.z;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorBodySet::AddImpulse(unsigned int const slotIndex,
+                              Vec3 const&        impulse)
+{
+    if (slotIndex >= m_flags.size()) return;
+
+    m_velocityXs[slotIndex] += impulse.x;
+    m_velocityYs[slotIndex] += impulse.y;
+    m_velocityZs[slotIndex] += impulse.z;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorBodySet::SetPosition(unsigned int const slotIndex,
+                               Vec3 const&        position)
+{
+    if (slotIndex >= m_flags.size()) return;
+
+    m_positionXs[slotIndex] = position.x;
+    m_positionYs[slotIndex] = position.y;
+    m_positionZs[slotIndex] = position.z;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorBodySet::SetFlag(unsigned int const slotIndex,
+                           uint8_t const      flag,
+                           bool const         isSet)
+{
+    if (slotIndex >= m_flags.size()) return;
+
+    if (isSet)
+    {
+        m_flags[slotIndex] |= flag;
+    }
+    else
+    {
+        m_flags[slotIndex] &= static_cast<uint8_t>(~flag);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 ActorBodySet::GetPosition(unsigned int const slotIndex) const
+{
+    if (slotIndex >= m_flags.size()) return Vec3::ZERO;
+
+    return Vec3(m_positionXs[slotIndex], m_positionYs[slotIndex], m_positionZs[slotIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 ActorBodySet::GetVelocity(unsigned int const slotIndex) const
+{
+    if (slotIndex >= m_flags.size()) return Vec3::ZERO;
+
+    return Vec3(m_velocityXs[slotIndex], m_velocityYs[slotIndex], m_velocityZs[slotIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+float ActorBodySet::GetRadius(unsigned int const slotIndex) const
+{
+    if (slotIndex >= m_flags.size()) return 0.f;
+
+    return m_radii[slotIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+float ActorBodySet::GetHeight(unsigned int const slotIndex) const
+{
+    if (slotIndex >= m_flags.size()) return 0.f;
+
+    return m_heights[slotIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ActorBodySet::HasFlag(unsigned int const slotIndex,
+                           uint8_t const      flag) const
+{
+    if (slotIndex >= m_flags.size()) return false;
+
+    return (m_flags[slotIndex] & flag) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ActorBodySet::GetSlotCount() const
+{
+    return static_cast<int>(m_flags.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t ActorBodySet::GetSizeBytes() const
+{
+    return m_flags.size() * (12 * sizeof(float) + sizeof(uint8_t));
+}
+
+#if defined(GAME_BENCHMARKS)
+//----------------------------------------------------------------------------------------------------
+// Headless comparison of the integration loop over 1k and 10k actors: the array-of-structures layout it replaced, with each
+// actor allocated on its own and padded with the cold bytes a real Actor carries, visited in a shuffled order like a
+// long-running game's heap; against this class. Both run the same float operations, so the final positions must match exactly.
+STATIC void ActorBodySet::RunBenchmark()
+{
+    constexpr int coldByteCount = 512;
+
+    struct BenchmarkActor
+    {
+        Vec3          m_position;
+        Vec3          m_velocity;
+        Vec3          m_acceleration;
+        float         m_drag            = 0.f;
+        bool          m_isSimulated     = true;
+        bool          m_isPinnedToFloor = false;
+        unsigned char m_coldBytes[coldByteCount];     // Stands in for definitions, weapons, animation and controller state.
+    };
+
+    int const   actorCounts[] = { 1000, 10000 };
+    int const   frameCount    = 200;
+    float const deltaSeconds  = 1.f / 60.f;
+
+    for (int const actorCount : actorCounts)
+    {
+        // 1. Build both layouts from the same random actors.
+        std::vector<BenchmarkActor*> actors;
+        ActorBodySet                 bodies;
+        actors.reserve(actorCount);
+
+        for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+        {
+            BenchmarkActor* actor    = new BenchmarkActor();
+            actor->m_position        = Vec3(g_theRNG->RollRandomFloatInRange(0.f, 64.f), g_theRNG->RollRandomFloatInRange(0.f, 64.f), 0.f);
+            actor->m_velocity        = Vec3(g_theRNG->RollRandomFloatInRange(-4.f, 4.f), g_theRNG->RollRandomFloatInRange(-4.f, 4.f), 0.f);
+            actor->m_drag            = g_theRNG->RollRandomFloatInRange(1.f, 10.f);
+            actor->m_isSimulated     = g_theRNG->RollRandomIntInRange(0, 15) != 0;
+            actor->m_isPinnedToFloor = g_theRNG->RollRandomIntInRange(0, 3) != 0;
+            actors.push_back(actor);
+
+            uint8_t flags = 0;
+            if (actor->m_isSimulated) flags |= BODY_SIMULATED;
+            if (actor->m_isPinnedToFloor) flags |= BODY_PINNED_TO_FLOOR;
+
+            bodies.AddBody(static_cast<unsigned int>(actorIndex), actor->m_position, actor->m_velocity, 0.5f, 1.f, actor->m_drag, flags);
+        }
+
+        std::vector<int> visitOrder(actorCount);
+
+        for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+        {
+            visitOrder[actorIndex] = actorIndex;
+        }
+
+        for (int actorIndex = actorCount - 1; actorIndex > 0; --actorIndex)
+        {
+            int const swapIndex = g_theRNG->RollRandomIntInRange(0, actorIndex);
+            std::swap(visitOrder[actorIndex], visitOrder[swapIndex]);
+        }
+
+        // 2. Apply the same steering force every frame, then integrate. The pointer loop walks a shuffled list and the
+        //    force loop walks it in slot order, as the old per-actor update and the controllers did.
+        double const pointerStart = GetCurrentTimeSeconds();
+
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+        {
+            for (int const actorIndex : visitOrder)
+            {
+                BenchmarkActor& actor = *actors[actorIndex];
+
+                actor.m_acceleration += Vec3(1.f, 0.5f, 0.f) * actor.m_drag;
+
+                if (!actor.m_isSimulated)
+                {
+                    actor.m_acceleration = Vec3::ZERO;
+                    continue;
+                }
+
+                actor.m_acceleration += -actor.m_velocity * actor.m_drag;
+                actor.m_velocity += actor.m_acceleration * deltaSeconds;
+                actor.m_position += actor.m_velocity * deltaSeconds;
+
+                if (actor.m_isPinnedToFloor)
+                {
+                    actor.m_position.z = 0.f;
+                }
+
+                actor.m_acceleration = Vec3::ZERO;
+            }
+        }
+
+        double const arrayStart = GetCurrentTimeSeconds();
+
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+        {
+            for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+            {
+                bodies.AddForce(static_cast<unsigned int>(actorIndex), Vec3(1.f, 0.5f, 0.f) * bodies.m_drags[actorIndex]);
+            }
+
+            bodies.Integrate(deltaSeconds);
+        }
+
+        double const arrayEnd = GetCurrentTimeSeconds();
+
+        // 3. Compare and report.
+        int mismatchCount = 0;
+
+        for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+        {
+            Vec3 const position = bodies.GetPosition(static_cast<unsigned int>(actorIndex));
+
+            if (position.x != actors[actorIndex]->m_position.x ||
+                position.y != actors[actorIndex]->m_position.y ||
+                position.z != actors[actorIndex]->m_position.z)
+            {
+                mismatchCount++;
+            }
+        }
+
+        for (BenchmarkActor*& actor : actors)
+        {
+            SafeDeletePointer(actor);
+        }
+
+        double const actorFrames = static_cast<double>(actorCount) * frameCount;
+        double const pointerNs   = (arrayStart - pointerStart) * 1e9 / actorFrames;
+        double const arrayNs     = (arrayEnd - arrayStart) * 1e9 / actorFrames;
+        String const report      = Stringf("Actor physics %d actors x %d frames: pointers %.2f ns/actor, arrays %.2f ns/actor, %d mismatches",
+                                           actorCount, frameCount, pointerNs, arrayNs, mismatchCount);
+
+        DebuggerPrintf("%s\n", report.c_str());
+        DebugAddMessage(report, 10.f);
+    }
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------
+void ActorBodySet::ClearEntry(unsigned int const slotIndex)
+{
+    m_positionXs[slotIndex]     = 0.f;
+    m_positionYs[slotIndex]     = 0.f;
+    m_positionZs[slotIndex]     = 0.f;
+    m_velocityXs[slotIndex]     = 0.f;
+    m_velocityYs[slotIndex]     = 0.f;
+    m_velocityZs[slotIndex]     = 0.f;
+    m_accelerationXs[slotIndex] = 0.f;
+    m_accelerationYs[slotIndex] = 0.f;
+    m_accelerationZs[slotIndex] = 0.f;
+    m_radii[slotIndex]          = 0.f;
+    m_heights[slotIndex]        = 0.f;
+    m_drags[slotIndex]          = 0.f;
+    m_flags[slotIndex]          = 0;
+}
@@ -0,0 +1,65 @@
+//----------------------------------------------------------------------------------------------------
+// ActorBodySet.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/Vec3.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Structure-of-arrays storage for the per-actor data the physics and collision loops touch every frame, indexed by actor
+// slot (ActorHandle::GetIndex()), so an entry stays put while the dense actor list is compacted around it.
+// Velocity and acceleration live only here; position, radius and height are written through by Map whenever the actor's own
+// copy changes, so Integrate and the collision narrow phase stream a handful of float arrays instead of visiting every Actor.
+class ActorBodySet
+{
+public:
+    void AddBody(unsigned int slotIndex, Vec3 const& position, Vec3 const& velocity, float radius, float height, float drag, uint8_t flags);
+    void RemoveBody(unsigned int slotIndex);
+
+    void Integrate(float deltaSeconds);
+    void IntegrateRange(float deltaSeconds, int beginSlotIndex, int endSlotIndex);
+
+    void AddForce(unsigned int slotIndex, Vec3 const& force);
+    void AddImpulse(unsigned int slotIndex, Vec3 const& impulse);
+    void SetPosition(unsigned int slotIndex, Vec3 const& position);
+    void SetFlag(unsigned int slotIndex, uint8_t flag, bool isSet);
+
+    Vec3   GetPosition(unsigned int slotIndex) const;
+    Vec3   GetVelocity(unsigned int slotIndex) const;
+    float  GetRadius(unsigned int slotIndex) const;
+    float  GetHeight(unsigned int slotIndex) const;
+    bool   HasFlag(unsigned int slotIndex, uint8_t flag) const;
+    int    GetSlotCount() const;
+    size_t GetSizeBytes() const;
+
+#if defined(GAME_BENCHMARKS)
+    static void RunBenchmark();
+#endif
+
+    static constexpr int     LANE_COUNT                = 4;         // Integrate runs four bodies per SSE instruction.
+    static constexpr uint8_t BODY_ACTIVE               = 1u << 0;   // Slot holds a live actor.
+    static constexpr uint8_t BODY_SIMULATED            = 1u << 1;   // Integrated each frame; cleared once the actor dies.
+    static constexpr uint8_t BODY_PINNED_TO_FLOOR      = 1u << 2;   // Position z is reset to 0 after integration (non-flying actors).
+    static constexpr uint8_t BODY_COLLIDES_WITH_ACTORS = 1u << 3;
+
+private:
+    void ClearEntry(unsigned int slotIndex);
+
+    std::vector<float>   m_positionXs;
+    std::vector<float>   m_positionYs;
+    std::vector<float>   m_positionZs;
+    std::vector<float>   m_velocityXs;
+    std::vector<float>   m_velocityYs;
+    std::vector<float>   m_velocityZs;
+    std::vector<float>   m_accelerationXs;  // Forces accumulated since the last Integrate, which clears them.
+    std::vector<float>   m_accelerationYs;
+    std::vector<float>   m_accelerationZs;
+    std::vector<float>   m_radii;
+    std::vector<float>   m_heights;
+    std::vector<float>   m_drags;
+    std::vector<uint8_t> m_flags;           // BODY_* bits; 0 for free slots and the padding up to a multiple of LANE_COUNT.
+};
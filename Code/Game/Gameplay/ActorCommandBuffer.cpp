@@ -0,0 +1,29 @@
+//----------------------------------------------------------------------------------------------------
+// ActorCommandBuffer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/ActorCommandBuffer.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void ActorCommandBuffer::Clear()
+{
+    m_commands.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorCommandBuffer::AddCommand(eActorCommandType const type,
+                                    ActorHandle const&      actorHandle)
+{
+    ActorCommand command;
+    command.m_type        = type;
+    command.m_actorHandle = actorHandle;
+
+    m_commands.push_back(command);
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<ActorCommand> const& ActorCommandBuffer::GetCommands() const
+{
+    return m_commands;
+}
@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------------------------------
+// ActorCommandBuffer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Game/Framework/ActorHandle.hpp"
+
+//----------------------------------------------------------------------------------------------------
+enum class eActorCommandType : int8_t
+{
+    FIRE_WEAPON,        // Fire the actor's current weapon and play its attack animation: damage, spawns and sounds.
+    STEER_WITH_PATH     // Run the actor's whole AI update serially, because its steering needs the map's path cache.
+};
+
+//----------------------------------------------------------------------------------------------------
+struct ActorCommand
+{
+    eActorCommandType m_type = eActorCommandType::FIRE_WEAPON;
+    ActorHandle       m_actorHandle;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Side effects recorded during the parallel actor update phase, for work that reaches beyond the actor being updated or into
+// state the map shares between actors. Map keeps one buffer per chunk of actors and executes them in chunk order afterwards,
+// so the effects happen in actor order whatever thread recorded them.
+class ActorCommandBuffer
+{
+public:
+    void Clear();
+    void AddCommand(eActorCommandType type, ActorHandle const& actorHandle);
+
+    std::vector<ActorCommand> const& GetCommands() const;
+
+private:
+    std::vector<ActorCommand> m_commands;   // In the order they were recorded.
+};
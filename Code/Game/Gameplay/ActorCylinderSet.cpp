@@ -0,0 +1,243 @@
+//----------------------------------------------------------------------------------------------------
+// ActorCylinderSet.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/ActorCylinderSet.hpp"
+
+#include <xmmintrin.h>
+
+#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Gameplay/Actor.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void ActorCylinderSet::Rebuild(std::vector<Actor*> const& actors)
+{
+    m_actorCount = static_cast<int>(actors.size());
+
+    size_t const paddedCount = static_cast<size_t>(m_actorCount + LANE_COUNT - 1) / LANE_COUNT * LANE_COUNT;
+
+    m_centerXs.resize(paddedCount);
+    m_centerYs.resize(paddedCount);
+    m_minZs.resize(paddedCount);
+    m_maxZs.resize(paddedCount);
+    m_radii.resize(paddedCount);
+    m_handles.resize(paddedCount);
+
+    for (unsigned int actorIndex = 0; actorIndex < paddedCount; ++actorIndex)
+    {
+        if (actorIndex < actors.size() && actors[actorIndex] != nullptr)
+        {
+            SetCylinder(actorIndex, *actors[actorIndex]);
+        }
+        else
+        {
+            ClearEntry(actorIndex);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Writes one actor's current cylinder, growing the arrays when the index is past the end (a freshly spawned actor).
+// Actors that do not collide with actors get an empty entry, so rays hit the same actors as ActorSpatialGrid holds.
+void ActorCylinderSet::SetCylinder(unsigned int const actorIndex,
+                                   Actor const&       actor)
+{
+    if (actorIndex >= m_centerXs.size())
+    {
+        size_t const oldPaddedCount = m_centerXs.size();
+        size_t const paddedCount    = (static_cast<size_t>(actorIndex) + LANE_COUNT) / LANE_COUNT * LANE_COUNT;
+
+        m_centerXs.resize(paddedCount);
+        m_centerYs.resize(paddedCount);
+        m_minZs.resize(paddedCount);
+        m_maxZs.resize(paddedCount);
+        m_radii.resize(paddedCount);
+        m_handles.resize(paddedCount);
+
+        for (size_t entryIndex = oldPaddedCount; entryIndex < paddedCount; ++entryIndex)
+        {
+            ClearEntry(static_cast<unsigned int>(entryIndex));
+        }
+    }
+
+    if (static_cast<int>(actorIndex) >= m_actorCount)
+    {
+        m_actorCount = static_cast<int>(actorIndex) + 1;
+    }
+
+    if (!actor.m_definition->m_collidesWithActors)
+    {
+        ClearEntry(actorIndex);
+        return;
+    }
+
+    Cylinder3 const& cylinder = actor.m_collisionCylinder;
+    Vec2 const       centerXY = cylinder.GetCenterPositionXY();
+    FloatRange const rangeZ   = cylinder.GetFloatRange();
+
+    m_centerXs[actorIndex] = centerXY.x;
+    m_centerYs[actorIndex] = centerXY.y;
+    m_minZs[actorIndex]    = rangeZ.m_min;
+    m_maxZs[actorIndex]    = rangeZ.m_max;
+    m_radii[actorIndex]    = cylinder.m_radius;
+    m_handles[actorIndex]  = actor.m_handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+RaycastResult3D ActorCylinderSet::RaycastClosest(Vec3 const&        startPosition,
+                                                 Vec3 const&        forwardNormal,
+                                                 float const        maxLength,
+                                                 ActorHandle const& ignoredHandle,
+                                                 ActorHandle&       out_impactedActorHandle) const
+{
+    RaycastResult3D closestResult;
+
+    RaycastClosestBatch(startPosition, &forwardNormal, 1, maxLength, ignoredHandle, &closestResult, &out_impactedActorHandle);
+
+    return closestResult;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Volley entry point: every ray shares the start position, and each gets its own closest hit and handle.
+// Results are default-constructed with an INVALID handle for rays that hit nothing.
+void ActorCylinderSet::RaycastClosestBatch(Vec3 const&        startPosition,
+                                           Vec3 const*        forwardNormals,
+                                           int const          rayCount,
+                                           float const        maxLength,
+                                           ActorHandle const& ignoredHandle,
+                                           RaycastResult3D*   out_results,
+                                           ActorHandle*       out_impactedActorHandles) const
+{
+    for (int rayIndex = 0; rayIndex < rayCount; ++rayIndex)
+    {
+        out_results[rayIndex]              = RaycastResult3D();
+        out_impactedActorHandles[rayIndex] = ActorHandle::INVALID;
+    }
+
+    RaycastBlocks(startPosition, forwardNormals, rayCount, maxLength, ignoredHandle, out_results, out_impactedActorHandles);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Exact test against one mirrored cylinder, for callers that already narrowed the actors down themselves.
+RaycastResult3D ActorCylinderSet::RaycastActor(unsigned int const actorIndex,
+                                               Vec3 const&        startPosition,
+                                               Vec3 const&        forwardNormal,
+                                               float const        maxLength) const
+{
+    return RaycastVsCylinderZ3D(startPosition,
+                                forwardNormal, maxLength,
+                                Vec2(m_centerXs[actorIndex], m_centerYs[actorIndex]),
+                                FloatRange(m_minZs[actorIndex], m_maxZs[actorIndex]),
+                                m_radii[actorIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+int ActorCylinderSet::GetActorCount() const
+{
+    return m_actorCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+ActorHandle ActorCylinderSet::GetHandle(unsigned int const actorIndex) const
+{
+    if (actorIndex >= m_handles.size()) return ActorHandle::INVALID;
+
+    return m_handles[actorIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorCylinderSet::ClearEntry(unsigned int const actorIndex)
+{
+    m_centerXs[actorIndex] = 0.f;
+    m_centerYs[actorIndex] = 0.f;
+    m_minZs[actorIndex]    = FLOAT_MAX;
+    m_maxZs[actorIndex]    = -FLOAT_MAX;
+    m_radii[actorIndex]    = 0.f;
+    m_handles[actorIndex]  = ActorHandle::INVALID;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A cylinder survives when the closest point of the ray segment to its axis is within the radius,
+// and the segment's Z span overlaps the cylinder's. Both tests are padded by BROADPHASE_MARGIN, so they only reject.
+// Survivors are tested exactly on the spot, so the query keeps no state between blocks and is safe to run from any thread.
+void ActorCylinderSet::RaycastBlocks(Vec3 const&        startPosition,
+                                     Vec3 const* const  forwardNormals,
+                                     int const          rayCount,
+                                     float const        maxLength,
+                                     ActorHandle const& ignoredHandle,
+                                     RaycastResult3D*   out_results,
+                                     ActorHandle*       out_impactedActorHandles) const
+{
+    int const    paddedCount = static_cast<int>(m_centerXs.size());
+    __m128 const startXs     = _mm_set1_ps(startPosition.x);
+    __m128 const startYs     = _mm_set1_ps(startPosition.y);
+    __m128 const margins     = _mm_set1_ps(BROADPHASE_MARGIN);
+    __m128 const zeros       = _mm_setzero_ps();
+    __m128 const maxLengths  = _mm_set1_ps(maxLength);
+
+    for (int blockStart = 0; blockStart < paddedCount; blockStart += LANE_COUNT)
+    {
+        // 1. Load the block once for the whole volley: centers relative to the shared start, padded radii and Z ranges.
+        __m128 const relativeXs   = _mm_sub_ps(_mm_loadu_ps(&m_centerXs[blockStart]), startXs);
+        __m128 const relativeYs   = _mm_sub_ps(_mm_loadu_ps(&m_centerYs[blockStart]), startYs);
+        __m128 const radii        = _mm_add_ps(_mm_loadu_ps(&m_radii[blockStart]), margins);
+        __m128 const radiiSquared = _mm_mul_ps(radii, radii);
+        __m128 const minZs        = _mm_sub_ps(_mm_loadu_ps(&m_minZs[blockStart]), margins);
+        __m128 const maxZs        = _mm_add_ps(_mm_loadu_ps(&m_maxZs[blockStart]), margins);
+
+        for (int rayIndex = 0; rayIndex < rayCount; ++rayIndex)
+        {
+            Vec3 const& forwardNormal          = forwardNormals[rayIndex];
+            float const lengthXYSquared        = forwardNormal.x * forwardNormal.x + forwardNormal.y * forwardNormal.y;
+            float const inverseLengthXYSquared = lengthXYSquared > 0.f ? 1.f / lengthXYSquared : 0.f;
+            float const endZ                   = startPosition.z + forwardNormal.z * maxLength;
+            __m128 const forwardXs             = _mm_set1_ps(forwardNormal.x);
+            __m128 const forwardYs             = _mm_set1_ps(forwardNormal.y);
+
+            // 2. XY: clamp the projection of each center onto the ray to [0, maxLength] and measure the distance there.
+            __m128 lengths = _mm_add_ps(_mm_mul_ps(relativeXs, forwardXs), _mm_mul_ps(relativeYs, forwardYs));
+            lengths        = _mm_mul_ps(lengths, _mm_set1_ps(inverseLengthXYSquared));
+            lengths        = _mm_min_ps(_mm_max_ps(lengths, zeros), maxLengths);
+
+            __m128 const offsetXs         = _mm_sub_ps(_mm_mul_ps(lengths, forwardXs), relativeXs);
+            __m128 const offsetYs         = _mm_sub_ps(_mm_mul_ps(lengths, forwardYs), relativeYs);
+            __m128 const distancesSquared = _mm_add_ps(_mm_mul_ps(offsetXs, offsetXs), _mm_mul_ps(offsetYs, offsetYs));
+            __m128 const insideXY         = _mm_cmple_ps(distancesSquared, radiiSquared);
+
+            // 3. Z: the segment's Z span overlaps the cylinder's.
+            __m128 const segmentMinZs = _mm_set1_ps(startPosition.z < endZ ? startPosition.z : endZ);
+            __m128 const segmentMaxZs = _mm_set1_ps(startPosition.z < endZ ? endZ : startPosition.z);
+            __m128 const overlapsZ    = _mm_and_ps(_mm_cmple_ps(segmentMinZs, maxZs), _mm_cmpge_ps(segmentMaxZs, minZs));
+
+            int const laneMask = _mm_movemask_ps(_mm_and_ps(insideXY, overlapsZ));
+
+            if (laneMask == 0) continue;
+
+            // 4. Survivors come in actor order for each ray, and only a strictly shorter hit replaces the current one,
+            // so ties resolve to the lowest actor index exactly like the plain loop.
+            for (int lane = 0; lane < LANE_COUNT; ++lane)
+            {
+                if ((laneMask >> lane & 1) == 0) continue;
+
+                int const actorIndex = blockStart + lane;
+
+                if (m_handles[actorIndex] == ignoredHandle) continue;
+
+                RaycastResult3D& closestResult = out_results[rayIndex];
+                float const      closestLength = closestResult.m_didImpact ? closestResult.m_impactLength : maxLength;
+
+                RaycastResult3D const result = RaycastActor(static_cast<unsigned int>(actorIndex), startPosition, forwardNormal, maxLength);
+
+                if (result.m_didImpact &&
+                    result.m_impactLength < closestLength)
+                {
+                    closestResult                      = result;
+                    out_impactedActorHandles[rayIndex] = m_handles[actorIndex];
+                }
+            }
+        }
+    }
+}
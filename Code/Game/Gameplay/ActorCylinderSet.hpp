@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------------------------------------
+// ActorCylinderSet.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Game/Framework/ActorHandle.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+
+//----------------------------------------------------------------------------------------------------
+// Structure-of-arrays mirror of the collision cylinders of actors that collide with actors, indexed like the actor list it was
+// rebuilt from; other actors keep an empty entry.
+// Ray queries run an SSE broadphase over four cylinders per instruction (XY distance from the ray segment and Z span overlap),
+// with the cylinder block loaded once for every ray of a volley that shares a start position. Only the survivors reach the
+// exact scalar RaycastVsCylinderZ3D, in actor order, so the closest hit and its handle match a plain loop over every actor.
+// Arrays are padded to a multiple of four with entries that can never pass.
+class ActorCylinderSet
+{
+public:
+    void Rebuild(std::vector<Actor*> const& actors);
+    void SetCylinder(unsigned int actorIndex, Actor const& actor);
+
+    RaycastResult3D RaycastClosest(Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength, ActorHandle const& ignoredHandle, ActorHandle& out_impactedActorHandle) const;
+    void            RaycastClosestBatch(Vec3 const& startPosition, Vec3 const* forwardNormals, int rayCount, float maxLength, ActorHandle const& ignoredHandle, RaycastResult3D* out_results, ActorHandle* out_impactedActorHandles) const;
+
+    RaycastResult3D RaycastActor(unsigned int actorIndex, Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
+
+    int         GetActorCount() const;
+    ActorHandle GetHandle(unsigned int actorIndex) const;
+
+    static constexpr int   LANE_COUNT        = 4;
+    static constexpr float BROADPHASE_MARGIN = 0.001f;  // Added to radii and Z ranges so float error never rejects a hit the scalar test would find.
+
+private:
+    void ClearEntry(unsigned int actorIndex);
+    void RaycastBlocks(Vec3 const& startPosition, Vec3 const* forwardNormals, int rayCount, float maxLength, ActorHandle const& ignoredHandle, RaycastResult3D* out_results, ActorHandle* out_impactedActorHandles) const;
+
+    int                      m_actorCount = 0;
+    std::vector<float>       m_centerXs;        // Padded to a multiple of LANE_COUNT.
+    std::vector<float>       m_centerYs;
+    std::vector<float>       m_minZs;           // Empty entries use FLOAT_MAX / -FLOAT_MAX so the Z test always fails.
+    std::vector<float>       m_maxZs;
+    std::vector<float>       m_radii;
+    std::vector<ActorHandle> m_handles;         // INVALID for empty entries.
+};
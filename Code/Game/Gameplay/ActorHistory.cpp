@@ -0,0 +1,198 @@
+//----------------------------------------------------------------------------------------------------
+// ActorHistory.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/ActorHistory.hpp"
+
+#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Gameplay/Actor.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void ActorHistory::Initialize(int const frameCount,
+                              int const slotCapacity)
+{
+    m_frameCount         = frameCount > 1 ? frameCount : 2;
+    m_slotCapacity       = slotCapacity > 0 ? slotCapacity : 1;
+    m_newestFrameIndex   = -1;
+    m_recordedFrameCount = 0;
+    m_tick               = 0;
+
+    m_frames.assign(m_frameCount, Frame());
+    m_snapshots.assign(static_cast<size_t>(m_frameCount) * m_slotCapacity, ActorSnapshot());
+    m_recordedSlotIndices.assign(static_cast<size_t>(m_frameCount) * m_slotCapacity, 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Overwrites the oldest frame. Actors whose slot index is past the slot capacity are not recorded,
+// so they cannot be hit by a rewound raycast.
+void ActorHistory::Record(std::vector<Actor*> const& actors,
+                          double const               timeSeconds)
+{
+    if (m_frameCount == 0) return;
+
+    m_tick++;
+    m_newestFrameIndex = (m_newestFrameIndex + 1) % m_frameCount;
+
+    if (m_recordedFrameCount < m_frameCount)
+    {
+        m_recordedFrameCount++;
+    }
+
+    Frame& frame        = m_frames[m_newestFrameIndex];
+    frame.m_timeSeconds = timeSeconds;
+    frame.m_tick        = m_tick;
+    frame.m_actorCount  = 0;
+
+    size_t const frameStart = static_cast<size_t>(m_newestFrameIndex) * m_slotCapacity;
+
+    for (Actor const* actor : actors)
+    {
+        if (actor == nullptr || !actor->m_handle.IsValid()) continue;
+        if (!actor->m_definition->m_collidesWithActors) continue;      // Not hittable now either, see ActorCylinderSet.
+
+        unsigned int const slotIndex = actor->m_handle.GetIndex();
+
+        if (slotIndex >= static_cast<unsigned int>(m_slotCapacity)) continue;
+
+        Cylinder3 const& cylinder = actor->m_collisionCylinder;
+        ActorSnapshot&   snapshot = m_snapshots[frameStart + slotIndex];
+
+        snapshot.m_position = cylinder.m_startPosition;
+        snapshot.m_height   = cylinder.m_endPosition.z - cylinder.m_startPosition.z;
+        snapshot.m_radius   = cylinder.m_radius;
+        snapshot.m_handle   = actor->m_handle;
+        snapshot.m_tick     = m_tick;
+
+        m_recordedSlotIndices[frameStart + frame.m_actorCount++] = slotIndex;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Tests the actors as they were at timeSeconds: the latest frame at or before that time is the actor set, and each actor's
+// cylinder is interpolated toward the next frame when the actor is recorded there too. Times before the oldest frame clamp
+// to it, and times after the newest frame use the newest frame as is. Same closest-hit rules as Map::RaycastWorldActors.
+RaycastResult3D ActorHistory::RaycastActorsAtTime(double const       timeSeconds,
+                                                  Vec3 const&        startPosition,
+                                                  Vec3 const&        forwardNormal,
+                                                  float const        maxLength,
+                                                  ActorHandle const& ignoredHandle,
+                                                  ActorHandle&       out_impactedActorHandle) const
+{
+    RaycastResult3D closestResult;
+    float           closestLength = maxLength;
+    out_impactedActorHandle       = ActorHandle::INVALID;
+
+    if (m_recordedFrameCount == 0) return closestResult;
+
+    // 1. Find the bracketing frames and the blend between them.
+    int olderFrameIndex = GetFrameIndexAtOrBefore(timeSeconds);
+    int newerFrameIndex = -1;
+
+    if (olderFrameIndex < 0)
+    {
+        olderFrameIndex = (m_newestFrameIndex - m_recordedFrameCount + 1 + m_frameCount) % m_frameCount;
+    }
+    else if (olderFrameIndex != m_newestFrameIndex)
+    {
+        newerFrameIndex = (olderFrameIndex + 1) % m_frameCount;
+    }
+
+    Frame const& olderFrame = m_frames[olderFrameIndex];
+    float        fraction   = 0.f;
+
+    if (newerFrameIndex >= 0)
+    {
+        double const frameSeconds = m_frames[newerFrameIndex].m_timeSeconds - olderFrame.m_timeSeconds;
+
+        if (frameSeconds > 0.0)
+        {
+            fraction = GetClamped(static_cast<float>((timeSeconds - olderFrame.m_timeSeconds) / frameSeconds), 0.f, 1.f);
+        }
+    }
+
+    // 2. Test each actor of the older frame at its blended position.
+    size_t const olderFrameStart = static_cast<size_t>(olderFrameIndex) * m_slotCapacity;
+
+    for (int recordIndex = 0; recordIndex < olderFrame.m_actorCount; ++recordIndex)
+    {
+        unsigned int const   slotIndex     = m_recordedSlotIndices[olderFrameStart + recordIndex];
+        ActorSnapshot const& olderSnapshot = m_snapshots[olderFrameStart + slotIndex];
+        ActorSnapshot const* newerSnapshot = newerFrameIndex >= 0 ? GetSnapshot(newerFrameIndex, slotIndex) : nullptr;
+        Vec3                 position      = olderSnapshot.m_position;
+
+        if (olderSnapshot.m_handle == ignoredHandle) continue;
+
+        if (newerSnapshot != nullptr && newerSnapshot->m_handle == olderSnapshot.m_handle)
+        {
+            position = olderSnapshot.m_position + (newerSnapshot->m_position - olderSnapshot.m_position) * fraction;
+        }
+
+        RaycastResult3D const result = RaycastVsCylinderZ3D(startPosition,
+                                                            forwardNormal, maxLength,
+                                                            Vec2(position.x, position.y),
+                                                            FloatRange(position.z, position.z + olderSnapshot.m_height),
+                                                            olderSnapshot.m_radius);
+
+        if (result.m_didImpact &&
+            result.m_impactLength < closestLength)
+        {
+            closestResult           = result;
+            closestLength           = result.m_impactLength;
+            out_impactedActorHandle = olderSnapshot.m_handle;
+        }
+    }
+
+    return closestResult;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ActorHistory::GetRecordedFrameCount() const
+{
+    return m_recordedFrameCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+double ActorHistory::GetOldestTimeSeconds() const
+{
+    if (m_recordedFrameCount == 0) return 0.0;
+
+    int const oldestFrameIndex = (m_newestFrameIndex - m_recordedFrameCount + 1 + m_frameCount) % m_frameCount;
+
+    return m_frames[oldestFrameIndex].m_timeSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t ActorHistory::GetSizeBytes() const
+{
+    return m_frames.size() * sizeof(Frame) +
+           m_snapshots.size() * sizeof(ActorSnapshot) +
+           m_recordedSlotIndices.size() * sizeof(unsigned int);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks back from the newest frame; returns -1 if every recorded frame is newer than timeSeconds.
+int ActorHistory::GetFrameIndexAtOrBefore(double const timeSeconds) const
+{
+    for (int age = 0; age < m_recordedFrameCount; ++age)
+    {
+        int const frameIndex = (m_newestFrameIndex - age + m_frameCount) % m_frameCount;
+
+        if (m_frames[frameIndex].m_timeSeconds <= timeSeconds) return frameIndex;
+    }
+
+    return -1;
+}
+
+//----------------------------------------------------------------------------------------------------
+ActorHistory::ActorSnapshot const* ActorHistory::GetSnapshot(int const          frameIndex,
+                                                             unsigned int const slotIndex) const
+{
+    ActorSnapshot const& snapshot = m_snapshots[static_cast<size_t>(frameIndex) * m_slotCapacity + slotIndex];
+
+    if (snapshot.m_tick != m_frames[frameIndex].m_tick) return nullptr;
+
+    return &snapshot;
+}
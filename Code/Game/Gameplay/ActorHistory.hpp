@@ -0,0 +1,60 @@
+//----------------------------------------------------------------------------------------------------
+// ActorHistory.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Game/Framework/ActorHandle.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+
+//----------------------------------------------------------------------------------------------------
+// Fixed-size ring of per-tick actor snapshots, used to rewind hitscans to a past view time (lag compensation).
+// Each frame has one snapshot per actor slot (slotIndex < slot capacity), so the same actor is found in two frames by
+// index instead of by search. A snapshot is only valid if its tick matches the frame's tick, so recording never clears
+// old entries and costs O(live actors). All storage is allocated once in Initialize.
+class ActorHistory
+{
+public:
+    void Initialize(int frameCount, int slotCapacity);
+    void Record(std::vector<Actor*> const& actors, double timeSeconds);
+
+    RaycastResult3D RaycastActorsAtTime(double timeSeconds, Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength, ActorHandle const& ignoredHandle, ActorHandle& out_impactedActorHandle) const;
+
+    int    GetRecordedFrameCount() const;
+    double GetOldestTimeSeconds() const;
+    size_t GetSizeBytes() const;
+
+private:
+    struct ActorSnapshot
+    {
+        Vec3         m_position;            // Bottom center of the collision cylinder.
+        float        m_height = 0.f;
+        float        m_radius = 0.f;
+        ActorHandle  m_handle;
+        unsigned int m_tick   = 0;          // Tick that wrote this entry; 0 never matches a frame.
+    };
+
+    struct Frame
+    {
+        double       m_timeSeconds = 0.0;
+        unsigned int m_tick        = 0;
+        int          m_actorCount  = 0;     // Number of slot indices recorded in this frame.
+    };
+
+    int                  GetFrameIndexAtOrBefore(double timeSeconds) const;
+    ActorSnapshot const* GetSnapshot(int frameIndex, unsigned int slotIndex) const;
+
+    int                        m_frameCount         = 0;
+    int                        m_slotCapacity       = 0;
+    int                        m_newestFrameIndex   = -1;
+    int                        m_recordedFrameCount = 0;
+    unsigned int               m_tick               = 0;
+    std::vector<Frame>         m_frames;
+    std::vector<ActorSnapshot> m_snapshots;             // Indexed by frameIndex * m_slotCapacity + slotIndex.
+    std::vector<unsigned int>  m_recordedSlotIndices;   // Same layout; the first m_actorCount of each frame are the slots recorded, in actor order.
+};
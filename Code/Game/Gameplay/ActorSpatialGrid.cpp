@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------------------------------
+// ActorSpatialGrid.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/ActorSpatialGrid.hpp"
+
+#include <algorithm>
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Gameplay/Actor.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void ActorSpatialGrid::Initialize(IntVec2 const& dimensions)
+{
+    m_dimensions = dimensions;
+
+    int const cellCount = m_dimensions.x * m_dimensions.y;
+
+    m_cellStarts.assign(static_cast<size_t>(cellCount) + 1, 0);
+    m_cellCursors.assign(cellCount, 0);
+    m_entries.clear();
+    m_actorCellIndices.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Only actors that collide with other actors are inserted, so SpawnPoints and hit effects never reach the narrow phase.
+void ActorSpatialGrid::Rebuild(std::vector<Actor*> const& actors)
+{
+    int const cellCount  = m_dimensions.x * m_dimensions.y;
+    int const actorCount = static_cast<int>(actors.size());
+
+    std::fill(m_cellStarts.begin(), m_cellStarts.end(), 0);
+    m_actorCellIndices.resize(actorCount);
+    m_maxActorRadius = 0.f;
+
+    // 1. Count how many actors fall into each cell.
+    for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+    {
+        Actor const* actor = actors[actorIndex];
+
+        if (actor == nullptr ||
+            !actor->m_handle.IsValid() ||
+            !actor->m_definition->m_collidesWithActors)
+        {
+            m_actorCellIndices[actorIndex] = -1;
+            continue;
+        }
+
+        IntVec2 const cellCoords = GetCellCoords(Vec2(actor->m_position.x, actor->m_position.y));
+        int const     cellIndex  = GetCellIndex(cellCoords.x, cellCoords.y);
+
+        m_actorCellIndices[actorIndex] = cellIndex;
+        m_cellStarts[cellIndex + 1]++;
+
+        if (actor->m_radius > m_maxActorRadius)
+        {
+            m_maxActorRadius = actor->m_radius;
+        }
+    }
+
+    // 2. Prefix sum the counts into bucket start offsets.
+    for (int cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+    {
+        m_cellStarts[cellIndex + 1] += m_cellStarts[cellIndex];
+        m_cellCursors[cellIndex] = m_cellStarts[cellIndex];
+    }
+
+    // 3. Scatter the actor indices into their buckets.
+    m_entries.resize(m_cellStarts[cellCount]);
+
+    for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+    {
+        int const cellIndex = m_actorCellIndices[actorIndex];
+
+        if (cellIndex < 0) continue;
+
+        m_entries[m_cellCursors[cellIndex]++] = static_cast<unsigned int>(actorIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Append the indices of every inserted actor whose cell overlaps the bounds.
+// Callers should pad the bounds by GetMaxActorRadius() when they need every actor whose disc could overlap.
+void ActorSpatialGrid::QueryActorIndices(AABB2 const&               bounds,
+                                         std::vector<unsigned int>& out_actorIndices) const
+{
+    out_actorIndices.clear();
+
+    if (m_dimensions.x <= 0 || m_dimensions.y <= 0) return;
+
+    IntVec2 const minCellCoords = GetCellCoords(bounds.m_mins);
+    IntVec2 const maxCellCoords = GetCellCoords(bounds.m_maxs);
+
+    for (int cellY = minCellCoords.y; cellY <= maxCellCoords.y; ++cellY)
+    {
+        for (int cellX = minCellCoords.x; cellX <= maxCellCoords.x; ++cellX)
+        {
+            int const cellIndex = GetCellIndex(cellX, cellY);
+            int const cellEnd   = m_cellStarts[cellIndex + 1];
+
+            for (int entryIndex = m_cellStarts[cellIndex]; entryIndex < cellEnd; ++entryIndex)
+            {
+                out_actorIndices.push_back(m_entries[entryIndex]);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Points out_actorIndices at one cell's bucket and returns its length, for callers that walk cells themselves and must not
+// fill a list.
+int ActorSpatialGrid::GetCellActorIndices(int const            cellIndex,
+                                          unsigned int const*& out_actorIndices) const
+{
+    int const cellStart = m_cellStarts[cellIndex];
+
+    out_actorIndices = m_entries.data() + cellStart;
+
+    return m_cellStarts[cellIndex + 1] - cellStart;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Positions outside the map are clamped into the border cells, so projectiles that leave the map are still found.
+IntVec2 ActorSpatialGrid::GetCellCoords(Vec2 const& positionXY) const
+{
+    int cellX = RoundDownToInt(positionXY.x);
+    int cellY = RoundDownToInt(positionXY.y);
+
+    if (cellX < 0) cellX = 0;
+    if (cellY < 0) cellY = 0;
+    if (cellX >= m_dimensions.x) cellX = m_dimensions.x - 1;
+    if (cellY >= m_dimensions.y) cellY = m_dimensions.y - 1;
+
+    return IntVec2(cellX, cellY);
+}
+
+//----------------------------------------------------------------------------------------------------
+int ActorSpatialGrid::GetCellIndex(int const cellX,
+                                   int const cellY) const
+{
+    return cellX + cellY * m_dimensions.x;
+}
+
+//----------------------------------------------------------------------------------------------------
+float ActorSpatialGrid::GetMaxActorRadius() const
+{
+    return m_maxActorRadius;
+}
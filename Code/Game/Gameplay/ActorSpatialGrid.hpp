@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------------------------------
+// ActorSpatialGrid.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+struct AABB2;
+struct Vec2;
+
+//----------------------------------------------------------------------------------------------------
+// Tile-aligned bucket grid used as the broadphase for actor queries.
+// Each map tile is one cell. Actors are bucketed by the cell containing their XY position,
+// and the buckets are stored contiguously (counting sort), so a rebuild never allocates after warm-up.
+// Entries are indices into the actor list the grid was rebuilt from.
+class ActorSpatialGrid
+{
+public:
+    void Initialize(IntVec2 const& dimensions);
+    void Rebuild(std::vector<Actor*> const& actors);
+    void QueryActorIndices(AABB2 const& bounds, std::vector<unsigned int>& out_actorIndices) const;
+    int  GetCellActorIndices(int cellIndex, unsigned int const*& out_actorIndices) const;
+
+    IntVec2 GetCellCoords(Vec2 const& positionXY) const;
+    int     GetCellIndex(int cellX, int cellY) const;
+    float   GetMaxActorRadius() const;
+
+private:
+    IntVec2                   m_dimensions = IntVec2::ZERO;
+    std::vector<int>          m_cellStarts;           // Size is cellCount + 1; bucket i is [m_cellStarts[i], m_cellStarts[i + 1]).
+    std::vector<int>          m_cellCursors;          // Scratch write cursors used while filling the buckets.
+    std::vector<int>          m_actorCellIndices;     // Scratch cell index for each actor, -1 if the actor is not inserted.
+    std::vector<unsigned int> m_entries;              // Actor indices sorted by cell.
+    float                     m_maxActorRadius = 0.f; // Largest radius inserted this rebuild, used to pad queries.
+};
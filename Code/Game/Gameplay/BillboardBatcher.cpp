@@ -0,0 +1,181 @@
+//----------------------------------------------------------------------------------------------------
+// BillboardBatcher.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/BillboardBatcher.hpp"
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/RenderStats.hpp"
+#include "Game/Gameplay/Map.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Empty every batch but keep its storage, then cache the billboard bases that only depend on the camera.
+void BillboardBatcher::BeginView(Mat44 const& cameraToWorldTransform)
+{
+    for (BillboardBatch& batch : m_batches)
+    {
+        batch.m_litVertexes.clear();
+        batch.m_unlitVertexes.clear();
+    }
+
+    m_cameraToWorldTransform  = cameraToWorldTransform;
+    m_fullOpposingRotation    = GetBillboardMatrix(eBillboardType::FULL_OPPOSING, cameraToWorldTransform, Vec3::ZERO);
+    m_worldUpOpposingRotation = GetBillboardMatrix(eBillboardType::WORLD_UP_OPPOSING, cameraToWorldTransform, Vec3::ZERO);
+    m_spriteCount             = 0;
+    m_drawCallCount           = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The sprite quad is built in local space (I forward, J left, K up) and transformed to world space on the CPU,
+// so every sprite in a batch can share the identity model constants.
+void BillboardBatcher::AddSprite(ActorDefinition const& definition,
+                                 Texture const&         texture,
+                                 AABB2 const&           UVs,
+                                 Mat44 const&           localToWorldTransform)
+{
+    bool const isLit     = definition.m_renderLit;
+    bool const isRounded = definition.m_renderRounded;
+
+    // There is no unlit rounded quad, and such sprites were never drawn by the per-actor path either.
+    if (!isLit && isRounded) return;
+
+    Vec2 const spriteOffset = -definition.m_size * definition.m_pivot;
+    Vec3 const bottomLeft   = Vec3(0.f, spriteOffset.x, spriteOffset.y);
+    Vec3 const bottomRight  = bottomLeft + Vec3(0.f, definition.m_size.x, 0.f);
+    Vec3 const topLeft      = bottomLeft + Vec3(0.f, 0.f, definition.m_size.y);
+    Vec3 const topRight     = bottomRight + Vec3(0.f, 0.f, definition.m_size.y);
+
+    BillboardBatch& batch = GetOrAddBatch(definition.m_shader, &texture, isLit, isRounded);
+
+    if (isRounded)
+    {
+        m_roundedQuadVertexes.clear();
+        AddVertsForRoundedQuad3D(m_roundedQuadVertexes, topRight, bottomRight, bottomLeft, topLeft, Rgba8::WHITE, UVs);
+
+        for (Vertex_PCUTBN vertex : m_roundedQuadVertexes)
+        {
+            vertex.m_position  = localToWorldTransform.TransformPosition3D(vertex.m_position);
+            vertex.m_tangent   = localToWorldTransform.TransformVectorQuantity3D(vertex.m_tangent);
+            vertex.m_bitangent = localToWorldTransform.TransformVectorQuantity3D(vertex.m_bitangent);
+            vertex.m_normal    = localToWorldTransform.TransformVectorQuantity3D(vertex.m_normal);
+            batch.m_litVertexes.push_back(vertex);
+        }
+    }
+    else
+    {
+        Vec3 const worldBottomLeft  = localToWorldTransform.TransformPosition3D(bottomLeft);
+        Vec3 const worldBottomRight = localToWorldTransform.TransformPosition3D(bottomRight);
+        Vec3 const worldTopLeft     = localToWorldTransform.TransformPosition3D(topLeft);
+        Vec3 const worldTopRight    = localToWorldTransform.TransformPosition3D(topRight);
+
+        if (isLit)
+        {
+            AddVertsForQuad3D(batch.m_litVertexes, worldBottomLeft, worldBottomRight, worldTopLeft, worldTopRight, Rgba8::WHITE, UVs);
+        }
+        else
+        {
+            AddVertsForQuad3D(batch.m_unlitVertexes, worldBottomLeft, worldBottomRight, worldTopLeft, worldTopRight, Rgba8::WHITE, UVs);
+        }
+    }
+
+    m_spriteCount++;
+}
+
+//----------------------------------------------------------------------------------------------------
+// One vertex upload and one draw call per non-empty batch.
+void BillboardBatcher::EndView(Map const& map)
+{
+    for (BillboardBatch const& batch : m_batches)
+    {
+        if (batch.m_litVertexes.empty() && batch.m_unlitVertexes.empty()) continue;
+
+        g_theRenderer->SetModelConstants();
+        g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
+        g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
+        g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
+        g_theRenderer->BindShader(batch.m_shader);
+        g_theRenderer->BindTexture(batch.m_texture);
+
+        if (batch.m_isLit)
+        {
+            g_theRenderer->SetLightConstants(map.m_sunDirection, map.m_sunIntensity, map.m_ambientIntensity);
+            g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
+            g_theRenderer->DrawVertexArray(batch.m_litVertexes);
+            g_renderStats.AddDrawCall(batch.m_litVertexes.size() * sizeof(Vertex_PCUTBN));
+        }
+        else
+        {
+            g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_NONE);
+            g_theRenderer->DrawVertexArray(batch.m_unlitVertexes);
+            g_renderStats.AddDrawCall(batch.m_unlitVertexes.size() * sizeof(Vertex_PCU));
+        }
+
+        m_drawCallCount++;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Opposing billboards reuse the rotation cached in BeginView and only need the translation set.
+Mat44 BillboardBatcher::GetBillboardTransform(eBillboardType const billboardType,
+                                              Vec3 const&          position) const
+{
+    if (billboardType == eBillboardType::FULL_OPPOSING)
+    {
+        Mat44 billboardTransform = m_fullOpposingRotation;
+        billboardTransform.SetTranslation3D(position);
+        return billboardTransform;
+    }
+
+    if (billboardType == eBillboardType::WORLD_UP_OPPOSING)
+    {
+        Mat44 billboardTransform = m_worldUpOpposingRotation;
+        billboardTransform.SetTranslation3D(position);
+        return billboardTransform;
+    }
+
+    return GetBillboardMatrix(billboardType, m_cameraToWorldTransform, position);
+}
+
+//----------------------------------------------------------------------------------------------------
+int BillboardBatcher::GetLastDrawCallCount() const
+{
+    return m_drawCallCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int BillboardBatcher::GetLastSpriteCount() const
+{
+    return m_spriteCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// There are only a handful of sprite sheets, so a linear search beats hashing here.
+BillboardBatch& BillboardBatcher::GetOrAddBatch(Shader*        shader,
+                                                Texture const* texture,
+                                                bool const     isLit,
+                                                bool const     isRounded)
+{
+    for (BillboardBatch& batch : m_batches)
+    {
+        if (batch.m_shader == shader &&
+            batch.m_texture == texture &&
+            batch.m_isLit == isLit &&
+            batch.m_isRounded == isRounded)
+        {
+            return batch;
+        }
+    }
+
+    BillboardBatch batch;
+    batch.m_shader    = shader;
+    batch.m_texture   = texture;
+    batch.m_isLit     = isLit;
+    batch.m_isRounded = isRounded;
+    m_batches.push_back(batch);
+
+    return m_batches.back();
+}
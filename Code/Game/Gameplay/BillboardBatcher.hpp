@@ -0,0 +1,61 @@
+//----------------------------------------------------------------------------------------------------
+// BillboardBatcher.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Map;
+class Shader;
+class Texture;
+struct AABB2;
+struct ActorDefinition;
+
+//----------------------------------------------------------------------------------------------------
+// Sprites that can be drawn with the same render state and one vertex upload.
+struct BillboardBatch
+{
+    Shader*           m_shader    = nullptr;
+    Texture const*    m_texture   = nullptr;
+    bool              m_isLit     = false;
+    bool              m_isRounded = false;
+    VertexList_PCUTBN m_litVertexes;
+    VertexList_PCU    m_unlitVertexes;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Collects actor and effect sprites for one view, already transformed to world space,
+// into batches keyed by shader, texture, lit and rounded variant, then draws each batch once.
+// Batches and their vertex lists persist across frames, so steady-state rendering does not allocate.
+class BillboardBatcher
+{
+public:
+    void BeginView(Mat44 const& cameraToWorldTransform);
+    void AddSprite(ActorDefinition const& definition, Texture const& texture, AABB2 const& UVs, Mat44 const& localToWorldTransform);
+    void EndView(Map const& map);
+
+    Mat44 GetBillboardTransform(eBillboardType billboardType, Vec3 const& position) const;
+    int   GetLastDrawCallCount() const;
+    int   GetLastSpriteCount() const;
+
+private:
+    BillboardBatch& GetOrAddBatch(Shader* shader, Texture const* texture, bool isLit, bool isRounded);
+
+    std::vector<BillboardBatch> m_batches;
+    VertexList_PCUTBN           m_roundedQuadVertexes;  // Scratch local-space rounded quad, reused for every rounded sprite.
+
+    // Camera basis for the current view; opposing billboards only depend on it, so they are computed once per view.
+    Mat44 m_cameraToWorldTransform;
+    Mat44 m_fullOpposingRotation;
+    Mat44 m_worldUpOpposingRotation;
+
+    int m_spriteCount   = 0;
+    int m_drawCallCount = 0;
+};
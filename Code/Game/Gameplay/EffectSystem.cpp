@@ -0,0 +1,157 @@
+//----------------------------------------------------------------------------------------------------
+// EffectSystem.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/EffectSystem.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/SpriteSheet.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Framework/AnimationGroup.hpp"
+#include "Game/Gameplay/BillboardBatcher.hpp"
+
+//----------------------------------------------------------------------------------------------------
+EffectSystem::EffectSystem(Map* owner)
+    : m_map(owner)
+{
+    m_effectTypes.reserve(MAX_EFFECT_TYPE_COUNT);
+    m_positions.resize(MAX_EFFECT_COUNT);
+    m_ages.resize(MAX_EFFECT_COUNT);
+    m_typeIndices.resize(MAX_EFFECT_COUNT);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Effects do not move, so updating is only aging them and discarding the expired ones.
+void EffectSystem::Update(float const deltaSeconds)
+{
+    int effectIndex = 0;
+
+    while (effectIndex < m_effectCount)
+    {
+        m_ages[effectIndex] += deltaSeconds;
+
+        if (m_ages[effectIndex] > m_effectTypes[m_typeIndices[effectIndex]].m_lifetime)
+        {
+            RemoveEffect(effectIndex);
+            continue;
+        }
+
+        effectIndex++;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Effects share the view's billboard batches with actors, so every sprite sheet is still a single draw call.
+// Effect billboards are opposing types, so their transform is the cached camera basis plus a translation.
+void EffectSystem::Render(BillboardBatcher& batcher) const
+{
+    if (m_effectCount == 0) return;
+
+    for (int typeIndex = 0; typeIndex < static_cast<int>(m_effectTypes.size()); ++typeIndex)
+    {
+        EffectType const&      effectType = m_effectTypes[typeIndex];
+        ActorDefinition const* definition = effectType.m_definition;
+
+        if (!definition->m_isVisible) continue;
+
+        Texture const&              texture   = definition->m_spriteSheet->GetTexture();
+        Vec3 const                  eyeHeight = definition->m_billboardType == eBillboardType::WORLD_UP_OPPOSING ? Vec3(0.f, 0.f, definition->m_eyeHeight) : Vec3::ZERO;
+        SpriteAnimDefinition const& animation = effectType.m_animation->GetSpriteAnimation(Vec3::X_BASIS);
+
+        for (int effectIndex = 0; effectIndex < m_effectCount; ++effectIndex)
+        {
+            if (m_typeIndices[effectIndex] != typeIndex) continue;
+
+            AABB2 const uvAtTime     = animation.GetSpriteDefAtTime(m_ages[effectIndex]).GetUVs();
+            Mat44 const localToWorld = batcher.GetBillboardTransform(definition->m_billboardType, m_positions[effectIndex] + eyeHeight);
+
+            batcher.AddSprite(*definition, texture, uvAtTime, localToWorld);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns false if the pool is full or the definition cannot be used as an effect; the effect is then simply not shown.
+bool EffectSystem::SpawnEffect(String const& definitionName,
+                               Vec3 const&   position)
+{
+    if (m_effectCount >= MAX_EFFECT_COUNT) return false;
+
+    int const typeIndex = GetOrAddEffectType(definitionName);
+
+    if (typeIndex < 0) return false;
+
+    m_positions[m_effectCount]   = position;
+    m_ages[m_effectCount]        = 0.f;
+    m_typeIndices[m_effectCount] = static_cast<unsigned char>(typeIndex);
+    m_effectCount++;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+int EffectSystem::GetEffectCount() const
+{
+    return m_effectCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int EffectSystem::GetOrAddEffectType(String const& definitionName)
+{
+    for (int typeIndex = 0; typeIndex < static_cast<int>(m_effectTypes.size()); ++typeIndex)
+    {
+        if (m_effectTypes[typeIndex].m_definition->m_name == definitionName)
+        {
+            return typeIndex;
+        }
+    }
+
+    if (static_cast<int>(m_effectTypes.size()) >= MAX_EFFECT_TYPE_COUNT)
+    {
+        ERROR_RECOVERABLE("Too many effect types")
+        return -1;
+    }
+
+    ActorDefinition* definition = ActorDefinition::GetDefByName(definitionName);
+
+    if (definition == nullptr)
+    {
+        ERROR_RECOVERABLE("Failed to find effect definition")
+        return -1;
+    }
+
+    AnimationGroup const* animation = definition->GetAnimationGroupByName("Death");
+
+    if (animation == nullptr && !definition->m_animationGroup.empty())
+    {
+        animation = &definition->m_animationGroup[0];
+    }
+
+    if (animation == nullptr || definition->m_spriteSheet == nullptr)
+    {
+        ERROR_RECOVERABLE("Effect definition has no animation")
+        return -1;
+    }
+
+    EffectType effectType;
+    effectType.m_definition = definition;
+    effectType.m_animation  = animation;
+    effectType.m_lifetime   = definition->m_corpseLifetime;
+    m_effectTypes.push_back(effectType);
+
+    return static_cast<int>(m_effectTypes.size()) - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Swap the last live effect into the removed slot, so the live range stays contiguous.
+void EffectSystem::RemoveEffect(int const effectIndex)
+{
+    int const lastIndex = m_effectCount - 1;
+
+    m_positions[effectIndex]   = m_positions[lastIndex];
+    m_ages[effectIndex]        = m_ages[lastIndex];
+    m_typeIndices[effectIndex] = m_typeIndices[lastIndex];
+    m_effectCount--;
+}
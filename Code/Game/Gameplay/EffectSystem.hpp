@@ -0,0 +1,58 @@
+//----------------------------------------------------------------------------------------------------
+// EffectSystem.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class AnimationGroup;
+class BillboardBatcher;
+class Map;
+struct ActorDefinition;
+
+//----------------------------------------------------------------------------------------------------
+// An effect type is an actor definition (e.g. BulletHit, BloodSplatter) whose "Death" animation
+// is played once at a fixed position and then discarded after the definition's corpse lifetime.
+struct EffectType
+{
+    ActorDefinition const* m_definition = nullptr;
+    AnimationGroup const*  m_animation  = nullptr;
+    float                  m_lifetime   = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Pooled, structure-of-arrays storage for short-lived visual effects.
+// Effects never become actors: they skip collision, physics and the per-actor draw path,
+// are aged in one tight loop, and are submitted straight to the view's BillboardBatcher.
+// All storage is reserved up front, so spawning and updating never allocate.
+class EffectSystem
+{
+public:
+    explicit EffectSystem(Map* owner);
+
+    void Update(float deltaSeconds);
+    void Render(BillboardBatcher& batcher) const;
+    bool SpawnEffect(String const& definitionName, Vec3 const& position);
+    int  GetEffectCount() const;
+
+    static constexpr int MAX_EFFECT_COUNT      = 2048;
+    static constexpr int MAX_EFFECT_TYPE_COUNT = 16;
+
+private:
+    int  GetOrAddEffectType(String const& definitionName);
+    void RemoveEffect(int effectIndex);
+
+    Map*                    m_map = nullptr;
+    std::vector<EffectType> m_effectTypes;
+
+    // Per-effect data, indexed by effect. Only the first m_effectCount entries are live.
+    std::vector<Vec3>          m_positions;
+    std::vector<float>         m_ages;
+    std::vector<unsigned char> m_typeIndices;
+    int                        m_effectCount = 0;
+};
@@ -0,0 +1,160 @@
+//----------------------------------------------------------------------------------------------------
+// FlowField.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/FlowField.hpp"
+
+#include <algorithm>
+
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Gameplay/Map.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void FlowField::Initialize(IntVec2 const& dimensions)
+{
+    int const tileCount = dimensions.x * dimensions.y;
+
+    m_dimensions = dimensions;
+    m_distances.assign(tileCount, FLOAT_MAX);
+    m_directions.assign(tileCount, Vec2::ZERO);
+    m_openHeap.reserve(tileCount);
+    m_isValid = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlowField::Build(Map const&     map,
+                      IntVec2 const& goalTileCoords)
+{
+    static IntVec2 const neighborOffsets[8] = { IntVec2(1, 0), IntVec2(-1, 0), IntVec2(0, 1), IntVec2(0, -1),
+                                                IntVec2(1, 1), IntVec2(-1, 1), IntVec2(1, -1), IntVec2(-1, -1) };
+    static float const   neighborCosts[8]   = { 1.f, 1.f, 1.f, 1.f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f };
+
+    auto const isFartherOnTop = [](OpenEntry const& a, OpenEntry const& b) { return a.m_distance > b.m_distance; };
+
+    m_goalTileCoords  = goalTileCoords;
+    m_isValid         = !map.IsTileCoordsOutOfBounds(goalTileCoords);
+    m_solidityVersion = map.GetSolidityVersion();
+
+    std::fill(m_distances.begin(), m_distances.end(), FLOAT_MAX);
+    std::fill(m_directions.begin(), m_directions.end(), Vec2::ZERO);
+
+    if (!m_isValid) return;
+
+    // 1. Dijkstra outward from the goal. Stale heap entries are skipped instead of decreased in place.
+    m_openHeap.clear();
+    m_distances[goalTileCoords.x + goalTileCoords.y * m_dimensions.x] = 0.f;
+    m_openHeap.push_back(OpenEntry{ 0.f, goalTileCoords.x + goalTileCoords.y * m_dimensions.x });
+
+    while (!m_openHeap.empty())
+    {
+        std::pop_heap(m_openHeap.begin(), m_openHeap.end(), isFartherOnTop);
+        OpenEntry const entry = m_openHeap.back();
+        m_openHeap.pop_back();
+
+        if (entry.m_distance > m_distances[entry.m_tileIndex]) continue;
+
+        IntVec2 const tileCoords = IntVec2(entry.m_tileIndex % m_dimensions.x, entry.m_tileIndex / m_dimensions.x);
+
+        for (int neighborIndex = 0; neighborIndex < 8; ++neighborIndex)
+        {
+            IntVec2 const offset         = neighborOffsets[neighborIndex];
+            IntVec2 const neighborCoords = IntVec2(tileCoords.x + offset.x, tileCoords.y + offset.y);
+
+            if (map.IsTileCoordsOutOfBounds(neighborCoords)) continue;
+            if (map.IsTileSolid(neighborCoords)) continue;
+
+            // No cutting corners: both tiles beside a diagonal step must be open.
+            if (offset.x != 0 && offset.y != 0 &&
+                (map.IsTileSolid(IntVec2(tileCoords.x + offset.x, tileCoords.y)) || map.IsTileSolid(IntVec2(tileCoords.x, tileCoords.y + offset.y))))
+            {
+                continue;
+            }
+
+            int const   neighborTileIndex = neighborCoords.x + neighborCoords.y * m_dimensions.x;
+            float const distance          = entry.m_distance + neighborCosts[neighborIndex];
+
+            if (distance >= m_distances[neighborTileIndex]) continue;
+
+            m_distances[neighborTileIndex] = distance;
+            m_openHeap.push_back(OpenEntry{ distance, neighborTileIndex });
+            std::push_heap(m_openHeap.begin(), m_openHeap.end(), isFartherOnTop);
+        }
+    }
+
+    // 2. Bake the downhill direction per reachable tile, so sampling is a single lookup.
+    for (int y = 0; y < m_dimensions.y; ++y)
+    {
+        for (int x = 0; x < m_dimensions.x; ++x)
+        {
+            int const tileIndex      = x + y * m_dimensions.x;
+            float     lowestDistance = m_distances[tileIndex];
+            IntVec2   bestOffset     = IntVec2::ZERO;
+
+            if (lowestDistance == FLOAT_MAX || lowestDistance == 0.f) continue;
+
+            for (int neighborIndex = 0; neighborIndex < 8; ++neighborIndex)
+            {
+                IntVec2 const offset         = neighborOffsets[neighborIndex];
+                IntVec2 const neighborCoords = IntVec2(x + offset.x, y + offset.y);
+
+                if (map.IsTileCoordsOutOfBounds(neighborCoords)) continue;
+
+                if (offset.x != 0 && offset.y != 0 &&
+                    (map.IsTileSolid(IntVec2(x + offset.x, y)) || map.IsTileSolid(IntVec2(x, y + offset.y))))
+                {
+                    continue;
+                }
+
+                float const neighborDistance = m_distances[neighborCoords.x + neighborCoords.y * m_dimensions.x];
+
+                if (neighborDistance < lowestDistance)
+                {
+                    lowestDistance = neighborDistance;
+                    bestOffset     = offset;
+                }
+            }
+
+            m_directions[tileIndex] = Vec2(static_cast<float>(bestOffset.x), static_cast<float>(bestOffset.y)).GetNormalized();
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlowField::Invalidate()
+{
+    m_targetHandle = ActorHandle::INVALID;
+    m_isValid      = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FlowField::IsValid() const
+{
+    return m_isValid;
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 FlowField::GetGoalTileCoords() const
+{
+    return m_goalTileCoords;
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned int FlowField::GetSolidityVersion() const
+{
+    return m_solidityVersion;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns zero on the goal tile, on unreachable tiles and outside the map; callers then steer straight at the target.
+Vec2 FlowField::GetDirection(IntVec2 const& tileCoords) const
+{
+    if (!m_isValid) return Vec2::ZERO;
+
+    if (tileCoords.x < 0 || tileCoords.y < 0 || tileCoords.x >= m_dimensions.x || tileCoords.y >= m_dimensions.y)
+    {
+        return Vec2::ZERO;
+    }
+
+    return m_directions[tileCoords.x + tileCoords.y * m_dimensions.x];
+}
@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------
+// FlowField.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Game/Framework/ActorHandle.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Map;
+
+//----------------------------------------------------------------------------------------------------
+// Dijkstra distance field over the tile grid toward one goal tile, with the downhill direction baked per tile.
+// It is built once when the goal tile changes, and then any number of agents can sample it in O(1).
+// Moves are 8-way; diagonals cannot cut the corner of a solid tile. All storage is reused between builds.
+class FlowField
+{
+public:
+    void Initialize(IntVec2 const& dimensions);
+    void Build(Map const& map, IntVec2 const& goalTileCoords);
+    void Invalidate();
+
+    bool         IsValid() const;
+    IntVec2      GetGoalTileCoords() const;
+    unsigned int GetSolidityVersion() const;
+    Vec2         GetDirection(IntVec2 const& tileCoords) const;
+
+    ActorHandle m_targetHandle;     // Actor the field leads to; its tile is the goal.
+
+private:
+    IntVec2            m_dimensions      = IntVec2::ZERO;
+    IntVec2            m_goalTileCoords  = IntVec2::ZERO;
+    bool               m_isValid         = false;
+    unsigned int       m_solidityVersion = 0;   // Map solidity version the field was built against.
+    std::vector<float> m_distances;             // Path length to the goal per tile, FLOAT_MAX if unreachable. Indexed by x + y * m_dimensions.x.
+    std::vector<Vec2>  m_directions;            // Normalized direction toward the cheapest neighbour, zero at the goal and where unreachable.
+
+    struct OpenEntry
+    {
+        float m_distance  = 0.f;
+        int   m_tileIndex = 0;
+    };
+
+    std::vector<OpenEntry> m_openHeap;  // Scratch binary heap for Dijkstra, smallest distance on top.
+};
@@ -49,6 +49,11 @@ Game::Game()
 
     m_gameClock = new Clock(Clock::GetSystemClock());
 
+    float const tickRateHz = g_gameConfigBlackboard.GetValue("Simulation.TickRateHz", 60.f);
+
+    m_simulationStepSeconds      = tickRateHz > 0.f ? 1.0 / static_cast<double>(tickRateHz) : 1.0 / 60.0;
+    m_maxSimulationStepsPerFrame = g_gameConfigBlackboard.GetValue("Simulation.MaxStepsPerFrame", 4);
+
     DebugAddWorldBasis(Mat44(), -1.f);
 
     Mat44 transform;
@@ -115,12 +120,43 @@ void Game::Update()
 
     if (m_currentMap != nullptr)
     {
-        m_currentMap->Update(gameDeltaSeconds);
+        m_currentMap->UpdateFromKeyboard();
+        UpdateSimulation(m_gameClock->GetDeltaSeconds());
     }
 
     m_gameStack.Update(1.0f);
 }
 
+//----------------------------------------------------------------------------------------------------
+// The map only ever advances by m_simulationStepSeconds, so a hitch cannot produce a huge step and the outcome does not
+// depend on the frame rate.
+// 1. Run every whole step the accumulated game time pays for, up to m_maxSimulationStepsPerFrame.
+// 2. Drop the whole steps the clamp left over, so one long hitch is not followed by frames of catching up.
+// 3. Let rendering interpolate the leftover fraction of a step.
+void Game::UpdateSimulation(double const deltaSeconds)
+{
+    m_simulationAccumulatorSeconds += deltaSeconds;
+    m_lastSimulationStepCount = 0;
+
+    while (m_simulationAccumulatorSeconds >= m_simulationStepSeconds &&
+           m_lastSimulationStepCount < m_maxSimulationStepsPerFrame)
+    {
+        m_currentMap->Update(static_cast<float>(m_simulationStepSeconds));
+        m_simulationAccumulatorSeconds -= m_simulationStepSeconds;
+        m_lastSimulationStepCount++;
+    }
+
+    if (m_simulationAccumulatorSeconds >= m_simulationStepSeconds)
+    {
+        int const droppedStepCount = static_cast<int>(m_simulationAccumulatorSeconds / m_simulationStepSeconds);
+
+        m_simulationAccumulatorSeconds -= static_cast<double>(droppedStepCount) * m_simulationStepSeconds;
+        m_droppedSimulationStepCount += droppedStepCount;
+    }
+
+    m_currentMap->SetInterpolationFraction(static_cast<float>(m_simulationAccumulatorSeconds / m_simulationStepSeconds));
+}
+
 //----------------------------------------------------------------------------------------------------
 void Game::Render() const
 {
@@ -469,7 +505,12 @@ void Game::UpdatePlayerController(float const deltaSeconds) const
     //     m_playerController->Update(systemDeltaSeconds);
     // }
 
-    DebugAddScreenText(Stringf("Time: %.2f\nFPS: %.2f\nScale: %.1f", m_gameClock->GetTotalSeconds(), 1.f / deltaSeconds, m_gameClock->GetTimeScale()), m_screenCamera->GetOrthographicTopRight() - Vec2(250.f, 60.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+    DebugAddScreenText(Stringf("Time: %.2f\nFPS: %.2f\nScale: %.1f\nSteps: %d (%d dropped)", m_gameClock->GetTotalSeconds(), 1.f / deltaSeconds, m_gameClock->GetTimeScale(), m_lastSimulationStepCount, m_droppedSimulationStepCount), m_screenCamera->GetOrthographicTopRight() - Vec2(250.f, 80.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+
+    if (m_currentMap != nullptr && m_currentMap->m_isStatsOverlayVisible)
+    {
+        DebugAddScreenText(m_currentMap->GetStatsOverlayText(), Vec2(10.f, m_screenCamera->GetOrthographicTopRight().y - 100.f), 16.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+    }
 
     /// PlayerController
     if (m_currentGameState == eGameState::INGAME)
@@ -57,6 +57,7 @@ private:
     void UpdateFromKeyBoard();
     void UpdateFromController();
     void UpdatePlayerController(float deltaSeconds) const;
+    void UpdateSimulation(double deltaSeconds);
     void UpdateListeners(float deltaSeconds) const;
     void RenderAttractMode() const;
     void RenderLobby() const;
@@ -69,6 +70,12 @@ private:
     eGameState        m_currentGameState = eGameState::ATTRACT;
     std::vector<Map*> m_maps;
 
+    double m_simulationStepSeconds        = 1.0 / 60.0;     // Delta of every Map::Update, from Simulation.TickRateHz.
+    double m_simulationAccumulatorSeconds = 0.0;            // Game time not simulated yet; less than one step between frames.
+    int    m_maxSimulationStepsPerFrame   = 4;              // Longer hitches are dropped instead of simulated in one burst.
+    int    m_lastSimulationStepCount      = 0;
+    int    m_droppedSimulationStepCount   = 0;              // Total steps dropped by the clamp, for the debug text.
+
 
 
     GameContext m_gameContext;
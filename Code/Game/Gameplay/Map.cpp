@@ -5,27 +5,36 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Gameplay/Map.hpp"
 
+#include <algorithm>
+
+#include "Engine/Core/Clock.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Input/InputSystem.hpp"
+#include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/FloatRange.hpp"
 #include "Engine/Math/MathUtils.hpp"
-#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/EffectSystem.hpp"
 #include "Game/Definition/ActorDefinition.hpp"
 #include "Game/Framework/ActorHandle.hpp"
 #include "Game/Framework/AIController.hpp"
+#include "Game/Gameplay/Weapon.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/JobSystem.hpp"
 #include "Game/Definition/MapDefinition.hpp"
 #include "Game/Framework/PlayerController.hpp"
-#include "Game/Gameplay/Tile.hpp"
+#include "Game/Framework/RenderStats.hpp"
+#include "Game/Framework/ViewFrustum.hpp"
 #include "Game/Definition/TileDefinition.hpp"
+#include "Game/Gameplay/TileRayWalker.hpp"
 
 //----------------------------------------------------------------------------------------------------
 Map::Map(Game*                owner,
@@ -35,16 +44,28 @@ Map::Map(Game*                owner,
 {
     m_dimensions = m_mapDefinition->m_image.GetDimensions();
 
-    m_vertexes.reserve(sizeof(AABB3) * m_dimensions.x * m_dimensions.y);
-    m_tiles.reserve(static_cast<unsigned int>(m_dimensions.x * m_dimensions.y));
     m_actors.reserve(100);
+    m_actorSlots.reserve(100);
 
     m_texture = m_mapDefinition->m_spriteSheetTexture;
     m_shader  = m_mapDefinition->m_shader;
 
-    CreateBuffers();
     CreateTiles();
+    m_pathfinder.Initialize(m_dimensions, &m_solidTileBits);
+    m_occupancyPyramid.Initialize(m_dimensions, &m_solidTileBits);
+    m_visibilitySet.LoadOrBake(m_dimensions, m_solidTileBits, m_solidityVersion, Stringf("Data/Cache/%s.pvs", m_mapDefinition->m_name.c_str()));
     CreateGeometry();
+    CreateBuffers();
+
+    m_actorGrid.Initialize(m_dimensions);
+    m_aiScheduler.Initialize(g_gameConfigBlackboard.GetValue("AI.PerceptionIntervalSeconds", 0.2f),
+                             g_gameConfigBlackboard.GetValue("AI.PerceptionBudgetMicroseconds", 500.f));
+    m_actorHistory.Initialize(g_gameConfigBlackboard.GetValue("History.FrameCount", 64),
+                              g_gameConfigBlackboard.GetValue("History.SlotCapacity", 256));
+    m_effectSystem = new EffectSystem(this);
+    m_isUpdateGraphSerial = g_gameConfigBlackboard.GetValue("Jobs.SerialUpdateGraph", false);
+    m_randomSeed          = static_cast<unsigned int>(g_gameConfigBlackboard.GetValue("Simulation.RandomSeed", 0));
+    CreateUpdateGraph();
 
     for (SpawnInfo const& spawnInfo : m_mapDefinition->m_spawnInfos)
     {
@@ -61,152 +82,339 @@ Map::Map(Game*                owner,
 //----------------------------------------------------------------------------------------------------
 Map::~Map()
 {
-    SafeDeletePointer(m_vertexBuffer);
-    SafeDeletePointer(m_indexBuffer);
+    SafeDeletePointer(m_effectSystem);
 
-    m_vertexes.clear();
-    m_tiles.clear();
-    m_indexes.clear();
+    for (MapChunk& chunk : m_chunks)
+    {
+        SafeDeletePointer(chunk.m_vertexBuffer);
+        SafeDeletePointer(chunk.m_indexBuffer);
+    }
+
+    m_chunks.clear();
 }
 
 //----------------------------------------------------------------------------------------------------
+// Decode the map image in one pass: one texel read and one hash lookup per pixel.
+// Each tile is stored as its tile definition index plus one solidity bit; every other property is read from the definition.
 void Map::CreateTiles()
 {
-    for (int i = 0; i < m_dimensions.x; ++i)
-    {
-        for (int j = 0; j < m_dimensions.y; ++j)
-        {
-            m_tiles.emplace_back();
-        }
-    }
+    int const tileCount = m_dimensions.x * m_dimensions.y;
+
+    m_tileDefinitionIndices.assign(static_cast<size_t>(tileCount), TileDefinition::INVALID_DEF_INDEX);
+    m_solidTileBits.assign(static_cast<size_t>(tileCount + 63) / 64, 0);
 
-    for (int i = 0; i < m_dimensions.x; ++i)
+    for (int y = 0; y < m_dimensions.y; ++y)
     {
-        for (int j = 0; j < m_dimensions.y; ++j)
+        for (int x = 0; x < m_dimensions.x; ++x)
         {
-            AABB3 const bounds = AABB3(Vec3(i, j, 0), Vec3(i + 1, j + 1, 1));
-            IntVec2     coords = IntVec2(bounds.m_mins.x, bounds.m_mins.y);
+            int const     tileIndex  = x + y * m_dimensions.x;
+            Rgba8 const   texelColor = m_mapDefinition->m_image.GetTexelColor(IntVec2(x, y));
+            uint8_t const defIndex   = TileDefinition::GetDefIndexByColor(texelColor);
 
-            for (TileDefinition const* tileDef : TileDefinition::s_tileDefinitions)
+            m_tileDefinitionIndices[tileIndex] = defIndex;
+
+            // Pixels with no matching tile definition stay non-solid, as before.
+            if (defIndex != TileDefinition::INVALID_DEF_INDEX && TileDefinition::s_tileDefinitions[defIndex]->m_isSolid)
             {
-                if (m_mapDefinition->m_image.GetTexelColor(coords) == tileDef->m_mapImagePixelColor)
-                {
-                    m_tiles[j + i * m_dimensions.y].m_bounds  = bounds;
-                    m_tiles[j + i * m_dimensions.y].m_name    = tileDef->m_name;
-                    m_tiles[j + i * m_dimensions.y].m_isSolid = tileDef->m_isSolid;
-                }
+                m_solidTileBits[tileIndex >> 6] |= 1ull << (tileIndex & 63);
             }
         }
     }
+
+    m_solidityVersion++;
+    m_wallDefinitionIndex  = TileDefinition::GetDefIndexByName("BrickWall");
+    m_floorDefinitionIndex = TileDefinition::GetDefIndexByName("StoneFloor");
 }
 
 //----------------------------------------------------------------------------------------------------
+// The map mesh is split into MAP_CHUNK_SIZE x MAP_CHUNK_SIZE tile chunks, so RenderMap can cull and order them per view.
+// Within a chunk, buried wall faces are dropped and runs of identical tiles are merged into larger quads.
 void Map::CreateGeometry()
 {
-    unsigned int      indexOffset          = 0;
     IntVec2 const     spriteSheetCellCount = m_mapDefinition->m_spriteSheetCellCount;
     SpriteSheet const spriteSheet          = SpriteSheet(*m_mapDefinition->m_spriteSheetTexture, spriteSheetCellCount);
 
-    for (int i = 0; i < m_dimensions.x; ++i)
+    m_chunkCounts = IntVec2((m_dimensions.x + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE, (m_dimensions.y + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE);
+    m_chunks.resize(static_cast<size_t>(m_chunkCounts.x) * m_chunkCounts.y);
+    m_visibleChunkIndices.reserve(m_chunks.size());
+
+    for (int chunkY = 0; chunkY < m_chunkCounts.y; ++chunkY)
     {
-        for (int j = 0; j < m_dimensions.y; ++j)
+        for (int chunkX = 0; chunkX < m_chunkCounts.x; ++chunkX)
         {
-            AABB3 const bounds = AABB3(Vec3(i, j, 0), Vec3(i + 1, j + 1, 1));
+            MapChunk&     chunk         = m_chunks[chunkX + chunkY * m_chunkCounts.x];
+            IntVec2 const minTileCoords = IntVec2(chunkX * MAP_CHUNK_SIZE, chunkY * MAP_CHUNK_SIZE);
+            IntVec2 const maxTileCoords = IntVec2(minTileCoords.x + MAP_CHUNK_SIZE < m_dimensions.x ? minTileCoords.x + MAP_CHUNK_SIZE : m_dimensions.x,
+                                                  minTileCoords.y + MAP_CHUNK_SIZE < m_dimensions.y ? minTileCoords.y + MAP_CHUNK_SIZE : m_dimensions.y);
+
+            chunk.m_bounds = AABB3(Vec3(minTileCoords.x, minTileCoords.y, 0), Vec3(maxTileCoords.x, maxTileCoords.y, 1));
+
+            AddGeometryForWalls(chunk, minTileCoords, maxTileCoords, spriteSheet);
+            AddGeometryForFloorsAndCeilings(chunk, minTileCoords, maxTileCoords, spriteSheet);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each of the four wall sides is scanned as lines of faces. Consecutive visible faces in a line
+// that belong to the same tile definition become one quad spanning the whole run.
+void Map::AddGeometryForWalls(MapChunk&          chunk,
+                              IntVec2 const&     minTileCoords,
+                              IntVec2 const&     maxTileCoords,
+                              SpriteSheet const& spriteSheet) const
+{
+    IntVec2 const faceDirections[4] = { IntVec2(1, 0), IntVec2(-1, 0), IntVec2(0, -1), IntVec2(0, 1) };
+
+    for (IntVec2 const& faceDirection : faceDirections)
+    {
+        bool const runsAlongY = faceDirection.x != 0;
+        int const  lineMin    = runsAlongY ? minTileCoords.x : minTileCoords.y;
+        int const  lineMax    = runsAlongY ? maxTileCoords.x : maxTileCoords.y;
+        int const  runMin     = runsAlongY ? minTileCoords.y : minTileCoords.x;
+        int const  runMax     = runsAlongY ? maxTileCoords.y : maxTileCoords.x;
 
-            IntVec2 currentTileCoords = IntVec2(i, j);
-            AABB2   wallUVs, floorUVs, ceilingUVs;
+        for (int line = lineMin; line < lineMax; ++line)
+        {
+            int runStart = runMin;
 
-            for (TileDefinition const* tileDef : TileDefinition::s_tileDefinitions)
+            while (runStart < runMax)
             {
-                if (m_mapDefinition->m_image.GetTexelColor(currentTileCoords) == tileDef->m_mapImagePixelColor)
+                IntVec2 const startTileCoords = runsAlongY ? IntVec2(line, runStart) : IntVec2(runStart, line);
+                uint8_t const defIndex        = GetVisibleWallFaceDefinitionIndex(startTileCoords, faceDirection);
+
+                if (defIndex == TileDefinition::INVALID_DEF_INDEX)
                 {
-                    wallUVs    = spriteSheet.GetSpriteUVs(tileDef->m_wallSpriteCoords.x + tileDef->m_wallSpriteCoords.y * 8);
-                    floorUVs   = spriteSheet.GetSpriteUVs(tileDef->m_floorSpriteCoords.x + tileDef->m_floorSpriteCoords.y * 8);
-                    ceilingUVs = spriteSheet.GetSpriteUVs(tileDef->m_ceilingSpriteCoords.x + tileDef->m_ceilingSpriteCoords.y * 8);
+                    runStart++;
+                    continue;
                 }
-            }
 
-            AddGeometryForWall(m_vertexes, m_indexes, bounds, wallUVs);
-            AddGeometryForFloor(m_vertexes, m_indexes, bounds, floorUVs);
-            AddGeometryForCeiling(m_vertexes, m_indexes, bounds, ceilingUVs);
-        }
+                int runEnd = runStart + 1;
+
+                while (runEnd < runMax &&
+                       GetVisibleWallFaceDefinitionIndex(runsAlongY ? IntVec2(line, runEnd) : IntVec2(runEnd, line), faceDirection) == defIndex)
+                {
+                    runEnd++;
+                }
 
-        indexOffset += 4;
+                TileDefinition const* tileDef = TileDefinition::s_tileDefinitions[defIndex];
+                AABB2 const           wallUVs = spriteSheet.GetSpriteUVs(tileDef->m_wallSpriteCoords.x + tileDef->m_wallSpriteCoords.y * 8);
+
+                AddGeometryForWallRun(chunk, faceDirection, line, runStart, runEnd, wallUVs);
+                runStart = runEnd;
+            }
+        }
     }
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::AddGeometryForWall(VertexList_PCUTBN& verts,
-                             IndexList&         indexes,
-                             AABB3 const&       bounds,
-                             AABB2 const&       UVs) const
+// Corner order matches the old per-tile faces, so normals and texture orientation are unchanged.
+void Map::AddGeometryForWallRun(MapChunk&      chunk,
+                                IntVec2 const& faceDirection,
+                                int const      line,
+                                int const      runStart,
+                                int const      runEnd,
+                                AABB2 const&   UVs) const
 {
-    Vec3 const frontBottomLeft  = Vec3(bounds.m_maxs.x, bounds.m_maxs.y - 1.f, bounds.m_maxs.z - 1.f);
-    Vec3 const frontBottomRight = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z - 1.f);
-    Vec3 const frontTopLeft     = Vec3(bounds.m_maxs.x, bounds.m_maxs.y - 1.f, bounds.m_maxs.z);
-    Vec3 const frontTopRight    = bounds.m_maxs;
-    Vec3 const backBottomLeft   = Vec3(bounds.m_mins.x, bounds.m_mins.y + 1.f, 0.f);
-    Vec3 const backBottomRight  = bounds.m_mins;
-    Vec3 const backTopLeft      = Vec3(bounds.m_mins.x, bounds.m_mins.y + 1.f, 1.f);
-    Vec3 const backTopRight     = Vec3(bounds.m_mins.x, bounds.m_mins.y, 1.f);
-
-    IntVec2 const currentTileCoords = IntVec2(bounds.m_mins.x, bounds.m_mins.y);
-    Tile const*   currentTile       = GetTile(currentTileCoords.x, currentTileCoords.y);
+    float const lineMin    = static_cast<float>(line);
+    float const lineMax    = static_cast<float>(line + 1);
+    float const start      = static_cast<float>(runStart);
+    float const end        = static_cast<float>(runEnd);
+    Vec2 const  tileCounts = Vec2(end - start, 1.f);
 
-    if (currentTile->m_name == "BrickWall")
+    if (faceDirection.x > 0)            // Front
+    {
+        AddVertsForTiledQuad3D(chunk.m_vertexes, chunk.m_indexes, Vec3(lineMax, start, 0.f), Vec3(lineMax, end, 0.f), Vec3(lineMax, start, 1.f), Vec3(lineMax, end, 1.f), tileCounts, UVs);
+    }
+    else if (faceDirection.x < 0)       // Back
     {
-        AddVertsForQuad3D(verts, indexes, frontBottomLeft, frontBottomRight, frontTopLeft, frontTopRight, Rgba8::WHITE, UVs);        // Front
-        AddVertsForQuad3D(verts, indexes, backBottomLeft, backBottomRight, backTopLeft, backTopRight, Rgba8::WHITE, UVs);            // Back
-        AddVertsForQuad3D(verts, indexes, backBottomRight, frontBottomLeft, backTopRight, frontTopLeft, Rgba8::WHITE, UVs);          // Left
-        AddVertsForQuad3D(verts, indexes, frontBottomRight, backBottomLeft, frontTopRight, backTopLeft, Rgba8::WHITE, UVs);          // Right
+        AddVertsForTiledQuad3D(chunk.m_vertexes, chunk.m_indexes, Vec3(lineMin, end, 0.f), Vec3(lineMin, start, 0.f), Vec3(lineMin, end, 1.f), Vec3(lineMin, start, 1.f), tileCounts, UVs);
+    }
+    else if (faceDirection.y < 0)       // Left
+    {
+        AddVertsForTiledQuad3D(chunk.m_vertexes, chunk.m_indexes, Vec3(start, lineMin, 0.f), Vec3(end, lineMin, 0.f), Vec3(start, lineMin, 1.f), Vec3(end, lineMin, 1.f), tileCounts, UVs);
+    }
+    else                                // Right
+    {
+        AddVertsForTiledQuad3D(chunk.m_vertexes, chunk.m_indexes, Vec3(end, lineMax, 0.f), Vec3(start, lineMax, 0.f), Vec3(end, lineMax, 1.f), Vec3(start, lineMax, 1.f), tileCounts, UVs);
     }
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::AddGeometryForFloor(VertexList_PCUTBN& verts,
-                              IndexList&         indexes,
-                              AABB3 const&       bounds,
-                              AABB2 const&       UVs) const
+// Greedy meshing: grow a rectangle of identical floor tiles along X first, then along Y while every row still matches.
+// Floor and ceiling sprites both come from the tile definition, so one rectangle serves both.
+void Map::AddGeometryForFloorsAndCeilings(MapChunk&          chunk,
+                                          IntVec2 const&     minTileCoords,
+                                          IntVec2 const&     maxTileCoords,
+                                          SpriteSheet const& spriteSheet) const
 {
-    Vec3 const frontBottomLeft  = Vec3(bounds.m_maxs.x, bounds.m_maxs.y - 1.f, bounds.m_maxs.z - 1.f);
-    Vec3 const frontBottomRight = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z - 1.f);
-    Vec3 const backBottomLeft   = Vec3(bounds.m_mins.x, bounds.m_mins.y + 1.f, 0.f);
-    Vec3 const backBottomRight  = bounds.m_mins;
+    IntVec2 const     chunkDimensions = IntVec2(maxTileCoords.x - minTileCoords.x, maxTileCoords.y - minTileCoords.y);
+    std::vector<bool> isMerged(static_cast<size_t>(chunkDimensions.x) * chunkDimensions.y, false);
 
-    IntVec2 const currentTileCoords = IntVec2(bounds.m_mins.x, bounds.m_mins.y);
-    Tile const*   currentTile       = GetTile(currentTileCoords.x, currentTileCoords.y);
-
-    if (currentTile->m_name == "StoneFloor")
+    for (int y = minTileCoords.y; y < maxTileCoords.y; ++y)
     {
-        AddVertsForQuad3D(verts, indexes, backBottomLeft, backBottomRight, frontBottomRight, frontBottomLeft, Rgba8::WHITE, UVs);
+        for (int x = minTileCoords.x; x < maxTileCoords.x; ++x)
+        {
+            uint8_t const defIndex = GetTileDefinitionIndex(x, y);
+
+            if (isMerged[(x - minTileCoords.x) + (y - minTileCoords.y) * chunkDimensions.x] || !HasFloorGeometry(defIndex)) continue;
+
+            // 1. Extend along X.
+            int maxX = x + 1;
+
+            while (maxX < maxTileCoords.x &&
+                   !isMerged[(maxX - minTileCoords.x) + (y - minTileCoords.y) * chunkDimensions.x] &&
+                   GetTileDefinitionIndex(maxX, y) == defIndex)
+            {
+                maxX++;
+            }
+
+            // 2. Extend along Y while the whole row matches.
+            int  maxY        = y + 1;
+            bool isRowUsable = true;
+
+            while (maxY < maxTileCoords.y && isRowUsable)
+            {
+                for (int rowX = x; rowX < maxX; ++rowX)
+                {
+                    if (isMerged[(rowX - minTileCoords.x) + (maxY - minTileCoords.y) * chunkDimensions.x] ||
+                        GetTileDefinitionIndex(rowX, maxY) != defIndex)
+                    {
+                        isRowUsable = false;
+                        break;
+                    }
+                }
+
+                if (isRowUsable) maxY++;
+            }
+
+            // 3. Claim the rectangle and emit one floor and one ceiling quad for it.
+            for (int mergedY = y; mergedY < maxY; ++mergedY)
+            {
+                for (int mergedX = x; mergedX < maxX; ++mergedX)
+                {
+                    isMerged[(mergedX - minTileCoords.x) + (mergedY - minTileCoords.y) * chunkDimensions.x] = true;
+                }
+            }
+
+            TileDefinition const* tileDef = TileDefinition::s_tileDefinitions[defIndex];
+
+            AABB2 const floorUVs   = spriteSheet.GetSpriteUVs(tileDef->m_floorSpriteCoords.x + tileDef->m_floorSpriteCoords.y * 8);
+            AABB2 const ceilingUVs = spriteSheet.GetSpriteUVs(tileDef->m_ceilingSpriteCoords.x + tileDef->m_ceilingSpriteCoords.y * 8);
+            float const minX       = static_cast<float>(x);
+            float const minY       = static_cast<float>(y);
+            float const maxXf      = static_cast<float>(maxX);
+            float const maxYf      = static_cast<float>(maxY);
+            Vec2 const  tileCounts = Vec2(maxYf - minY, maxXf - minX);
+
+            AddVertsForTiledQuad3D(chunk.m_vertexes, chunk.m_indexes, Vec3(minX, maxYf, 0.f), Vec3(minX, minY, 0.f), Vec3(maxXf, maxYf, 0.f), Vec3(maxXf, minY, 0.f), tileCounts, floorUVs);
+            AddVertsForTiledQuad3D(chunk.m_vertexes, chunk.m_indexes, Vec3(minX, minY, 1.f), Vec3(minX, maxYf, 1.f), Vec3(maxXf, minY, 1.f), Vec3(maxXf, maxYf, 1.f), tileCounts, ceilingUVs);
+        }
     }
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::AddGeometryForCeiling(VertexList_PCUTBN& verts,
-                                IndexList&         indexes,
-                                AABB3 const&       bounds,
-                                AABB2 const&       UVs) const
+// A quad covering tileCounts tiles. The UVs are in tile units, and the atlas cell to repeat is stored in the
+// tangent (mins) and bitangent (maxs); MapDiffuse.hlsl wraps the UVs into that cell, so the sprite tiles across the quad.
+// The map is lit with vertex normals only, so the tangent frame is free to carry this.
+void Map::AddVertsForTiledQuad3D(VertexList_PCUTBN& verts,
+                                 IndexList&         indexes,
+                                 Vec3 const&        bottomLeft,
+                                 Vec3 const&        bottomRight,
+                                 Vec3 const&        topLeft,
+                                 Vec3 const&        topRight,
+                                 Vec2 const&        tileCounts,
+                                 AABB2 const&       cellUVs) const
+{
+    unsigned int const firstIndex = static_cast<unsigned int>(verts.size());
+
+    Vertex_PCUTBN vertex;
+    vertex.m_color     = Rgba8::WHITE;
+    vertex.m_tangent   = Vec3(cellUVs.m_mins.x, cellUVs.m_mins.y, 0.f);
+    vertex.m_bitangent = Vec3(cellUVs.m_maxs.x, cellUVs.m_maxs.y, 0.f);
+    vertex.m_normal    = CrossProduct3D(bottomRight - bottomLeft, topLeft - bottomLeft).GetNormalized();
+
+    vertex.m_position    = bottomLeft;
+    vertex.m_uvTexCoords = Vec2(0.f, 0.f);
+    verts.push_back(vertex);
+
+    vertex.m_position    = bottomRight;
+    vertex.m_uvTexCoords = Vec2(tileCounts.x, 0.f);
+    verts.push_back(vertex);
+
+    vertex.m_position    = topRight;
+    vertex.m_uvTexCoords = Vec2(tileCounts.x, tileCounts.y);
+    verts.push_back(vertex);
+
+    vertex.m_position    = topLeft;
+    vertex.m_uvTexCoords = Vec2(0.f, tileCounts.y);
+    verts.push_back(vertex);
+
+    indexes.push_back(firstIndex);
+    indexes.push_back(firstIndex + 1);
+    indexes.push_back(firstIndex + 2);
+    indexes.push_back(firstIndex);
+    indexes.push_back(firstIndex + 2);
+    indexes.push_back(firstIndex + 3);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns the wall tile's definition index if its face toward faceDirection can be seen, INVALID_DEF_INDEX otherwise.
+// A face is buried when the neighbour also has wall geometry; faces on the map border are kept.
+uint8_t Map::GetVisibleWallFaceDefinitionIndex(IntVec2 const& tileCoords,
+                                               IntVec2 const& faceDirection) const
 {
-    Vec3 const frontTopLeft  = Vec3(bounds.m_maxs.x, bounds.m_maxs.y - 1.f, bounds.m_maxs.z);
-    Vec3 const frontTopRight = bounds.m_maxs;
-    Vec3 const backTopLeft   = Vec3(bounds.m_mins.x, bounds.m_mins.y + 1.f, 1.f);
-    Vec3 const backTopRight  = Vec3(bounds.m_mins.x, bounds.m_mins.y, 1.f);
+    uint8_t const defIndex = GetTileDefinitionIndex(tileCoords.x, tileCoords.y);
+
+    if (!HasWallGeometry(defIndex)) return TileDefinition::INVALID_DEF_INDEX;
 
-    IntVec2 const currentTileCoords = IntVec2(bounds.m_mins.x, bounds.m_mins.y);
-    Tile const*   currentTile       = GetTile(currentTileCoords.x, currentTileCoords.y);
+    IntVec2 const neighborCoords = IntVec2(tileCoords.x + faceDirection.x, tileCoords.y + faceDirection.y);
 
-    if (currentTile->m_name == "StoneFloor")
+    if (!IsTileCoordsOutOfBounds(neighborCoords) && HasWallGeometry(GetTileDefinitionIndex(neighborCoords.x, neighborCoords.y)))
     {
-        AddVertsForQuad3D(verts, indexes, backTopRight, backTopLeft, frontTopLeft, frontTopRight, Rgba8::WHITE, UVs);
+        return TileDefinition::INVALID_DEF_INDEX;
     }
+
+    return defIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Only BrickWall tiles get walls, and only StoneFloor tiles get a floor and ceiling.
+// Both indices are resolved once in CreateTiles, so the mesh builders never compare names.
+bool Map::HasWallGeometry(uint8_t const defIndex) const
+{
+    return defIndex != TileDefinition::INVALID_DEF_INDEX && defIndex == m_wallDefinitionIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool Map::HasFloorGeometry(uint8_t const defIndex) const
+{
+    return defIndex != TileDefinition::INVALID_DEF_INDEX && defIndex == m_floorDefinitionIndex;
 }
 
 //----------------------------------------------------------------------------------------------------
+// The map geometry never changes, so every chunk is uploaded once here and RenderMap only binds and draws it.
+// The CPU copies are released afterwards.
 void Map::CreateBuffers()
 {
-    m_vertexBuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
-    m_indexBuffer  = g_theRenderer->CreateIndexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
+    for (MapChunk& chunk : m_chunks)
+    {
+        if (chunk.m_indexes.empty()) continue;
+
+        unsigned int const vertexBufferSize = static_cast<unsigned int>(chunk.m_vertexes.size() * sizeof(Vertex_PCUTBN));
+        unsigned int const indexBufferSize  = static_cast<unsigned int>(chunk.m_indexes.size() * sizeof(unsigned int));
+
+        chunk.m_vertexBuffer = g_theRenderer->CreateVertexBuffer(vertexBufferSize, sizeof(Vertex_PCUTBN));
+        chunk.m_indexBuffer  = g_theRenderer->CreateIndexBuffer(indexBufferSize, sizeof(unsigned int));
+
+        g_theRenderer->CopyCPUToGPU(chunk.m_vertexes.data(), vertexBufferSize, chunk.m_vertexBuffer);
+        g_theRenderer->CopyCPUToGPU(chunk.m_indexes.data(), indexBufferSize, chunk.m_indexBuffer);
+        g_renderStats.AddUpload(static_cast<size_t>(vertexBufferSize) + indexBufferSize);
+
+        chunk.m_indexCount = static_cast<unsigned int>(chunk.m_indexes.size());
+
+        VertexList_PCUTBN().swap(chunk.m_vertexes);
+        IndexList().swap(chunk.m_indexes);
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -238,9 +446,35 @@ bool Map::IsTileCoordsOutOfBounds(int const x,
 }
 
 //----------------------------------------------------------------------------------------------------
+// Reads one bit of the solidity bitset. Tiles outside the map are not solid.
 bool Map::IsTileSolid(IntVec2 const& tileCoords) const
 {
-    return GetTile(tileCoords.x, tileCoords.y)->m_isSolid;
+    if (IsTileCoordsOutOfBounds(tileCoords)) return false;
+
+    int const tileIndex = tileCoords.x + tileCoords.y * m_dimensions.x;
+
+    return (m_solidTileBits[tileIndex >> 6] >> (tileIndex & 63) & 1ull) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Changes collision and pathing only; the map mesh is static and is not rebuilt.
+void Map::SetTileSolid(IntVec2 const& tileCoords,
+                       bool const     isSolid)
+{
+    if (IsTileCoordsOutOfBounds(tileCoords)) return;
+    if (IsTileSolid(tileCoords) == isSolid) return;
+
+    int const tileIndex = tileCoords.x + tileCoords.y * m_dimensions.x;
+
+    m_solidTileBits[tileIndex >> 6] ^= 1ull << (tileIndex & 63);
+    m_occupancyPyramid.OnTileChanged(tileCoords);
+    m_solidityVersion++;
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned int Map::GetSolidityVersion() const
+{
+    return m_solidityVersion;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -253,47 +487,137 @@ IntVec2 const Map::GetTileCoordsFromWorldPos(Vec3 const& worldPosition) const
 }
 
 //----------------------------------------------------------------------------------------------------
-Tile const* Map::GetTile(int const x,
-                         int const y) const
+// Tiles are unit cubes on the grid, so their bounds follow from the coordinates alone.
+AABB3 Map::GetTileBounds(IntVec2 const& tileCoords) const
 {
-    if (IsTileCoordsOutOfBounds(x, y))
-    {
-        ERROR_AND_DIE("tileCoords is out of bound!")
-    }
+    Vec3 const mins = Vec3(static_cast<float>(tileCoords.x), static_cast<float>(tileCoords.y), 0.f);
 
-    return &m_tiles[y + x * m_dimensions.y];
+    return AABB3(mins, mins + Vec3(1.f, 1.f, 1.f));
 }
 
 //----------------------------------------------------------------------------------------------------
-Tile const* Map::GetTile(IntVec2 const& tileCoords) const
+// Unchecked: callers iterate inside the map dimensions.
+uint8_t Map::GetTileDefinitionIndex(int const x,
+                                    int const y) const
 {
-    return GetTile(tileCoords.x, tileCoords.y);
+    return m_tileDefinitionIndices[x + y * m_dimensions.x];
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::Update(float const deltaSeconds)
+// The phases of Update as tasks, added in the order Update used to call them, each naming the tasks whose output it reads
+// or whose data it writes after them:
+//  - Perception reads the actors where the previous frame left them, through the grid rebuilt before anything moves.
+//  - Integration touches only the body arrays, so it overlaps the grid rebuild, perception and flow fields; the copy back to
+//    the actors waits for every reader of the old positions.
+//  - Effects only age and expire, so they overlap the second grid rebuild.
+//  - Map collision of one actor reads and writes only that actor and its body, so it runs in chunks.
+// The serial actor update, actor pair collision and everything that spawns or deletes actors stay on the main thread.
+// Keyboard input is not part of the graph: Game calls UpdateFromKeyboard once per frame, however many steps the frame runs.
+void Map::CreateUpdateGraph()
 {
-    UpdateFromKeyboard();
-    UpdateAllActors(deltaSeconds);
-    CollideActors();
-    CollideActorsWithMap();
-    DeleteDestroyedActor();
-    for (PlayerController* controller : g_theGame->m_localPlayerControllerList)
+    int const savePrevious = m_updateGraph.AddParallelTask("Actors.SavePrevious", {}, [this]
     {
-        if (!controller->GetActor())
-        {
-            Actor* playerActor = SpawnPlayer(controller);
+        return static_cast<int>(m_actors.size());
+    }, ACTOR_CHUNK_SIZE, [this](int, int const beginIndex, int const endIndex)
+    {
+        SavePreviousActorTransforms(beginIndex, endIndex);
+    });
 
+    int const gridBeforeMove = m_updateGraph.AddTask("ActorGrid.BeforeMove", {}, [this]
+    {
+        m_actorGrid.Rebuild(m_actors);     // Perception queries read this frame's positions and indices.
+    });
 
-            controller->Possess(playerActor->m_handle);
-        }
-    }
-    // if (!m_game->GetPlayerController()->GetActor())
-    // {
-    //     Actor const* playerActor = SpawnPlayer(m_game->GetPlayerController());
-    //
-    //     m_game->GetPlayerController()->Possess(playerActor->m_handle);
-    // }
+    int const perception = m_updateGraph.AddTask("AI.Perception", { gridBeforeMove }, [this]
+    {
+        m_aiScheduler.Update(*this, m_updateDeltaSeconds);
+    });
+
+    int const flowFields = m_updateGraph.AddTask("FlowFields", {}, [this]
+    {
+        UpdateFlowFields();
+    });
+
+    int const playerIntents = m_updateGraph.AddTask("Players.ApplyIntent", {}, [this]
+    {
+        ApplyPlayerMoveIntents();
+    });
+
+    int const integrate = m_updateGraph.AddParallelTask("Physics.Integrate", { playerIntents }, [this]
+    {
+        return m_actorBodies.GetSlotCount();
+    }, ACTOR_CHUNK_SIZE, [this](int, int const beginIndex, int const endIndex)
+    {
+        IntegrateActorBodies(m_updateDeltaSeconds, beginIndex, endIndex);
+    });
+
+    int const copyPositions = m_updateGraph.AddParallelTask("Physics.CopyBack", { savePrevious, integrate, gridBeforeMove, perception, flowFields }, [this]
+    {
+        return static_cast<int>(m_actors.size());
+    }, ACTOR_CHUNK_SIZE, [this](int, int const beginIndex, int const endIndex)
+    {
+        CopyActorBodyPositions(beginIndex, endIndex);
+    });
+
+    int const steer = m_updateGraph.AddParallelTask("AI.Steer", { copyPositions }, [this]
+    {
+        return PrepareActorCommandBuffers();
+    }, ACTOR_CHUNK_SIZE, [this](int const chunkIndex, int const beginIndex, int const endIndex)
+    {
+        SteerActors(m_updateDeltaSeconds, chunkIndex, beginIndex, endIndex);
+    });
+
+    int const updateActors = m_updateGraph.AddMainThreadTask("Actors.Update", { steer }, [this]
+    {
+        UpdateAllActors(m_updateDeltaSeconds);
+    });
+
+    m_updateGraph.AddTask("Effects.Update", { updateActors }, [this]
+    {
+        m_effectSystem->Update(m_updateDeltaSeconds);
+    });
+
+    int const gridAfterMove = m_updateGraph.AddTask("ActorGrid.AfterMove", { updateActors }, [this]
+    {
+        m_actorGrid.Rebuild(m_actors);
+    });
+
+    int const collideActors = m_updateGraph.AddMainThreadTask("Collide.Actors", { gridAfterMove }, [this]
+    {
+        CollideActors();
+    });
+
+    int const collideMap = m_updateGraph.AddParallelTask("Collide.Map", { collideActors }, [this]
+    {
+        return static_cast<int>(m_actors.size());
+    }, ACTOR_CHUNK_SIZE, [this](int, int const beginIndex, int const endIndex)
+    {
+        CollideActorsWithMap(beginIndex, endIndex);
+    });
+
+    int const deleteActors = m_updateGraph.AddMainThreadTask("Actors.Delete", { collideMap }, [this]
+    {
+        DeleteDestroyedActor();
+        m_actorCylinders.Rebuild(m_actors);     // Deletion compacted m_actors, so realign the raycast mirror with it.
+        m_actorGrid.Rebuild(m_actors);          // And the grid, whose indices raycasts between updates (player fire) still use.
+        m_actorHistory.Record(m_actors, m_simulationSeconds);
+    });
+
+    m_updateGraph.AddMainThreadTask("Players.Respawn", { deleteActors }, [this]
+    {
+        RespawnPlayers();
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+// One fixed simulation step; Game::UpdateSimulation calls it zero or more times per frame.
+void Map::Update(float const deltaSeconds)
+{
+    m_updateDeltaSeconds = deltaSeconds;
+    m_simulationSeconds += deltaSeconds;
+    m_tickIndex++;
+
+    m_updateGraph.Execute(*g_theJobSystem, m_isUpdateGraphSerial);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -301,6 +625,7 @@ void Map::UpdateFromKeyboard()
 {
     if (g_theInput->WasKeyJustPressed(KEYCODE_I))
     {
+        m_isStatsOverlayVisible = !m_isStatsOverlayVisible;
         DebugAddMessage(Stringf("Sun Direction: (%.2f, %.2f, %.2f)", m_sunDirection.x, m_sunDirection.y, m_sunDirection.z), 5.f);
     }
 
@@ -355,11 +680,113 @@ void Map::UpdateFromKeyboard()
         m_ambientIntensity = GetClampedZeroToOne(m_ambientIntensity);
         DebugAddMessage(Stringf("Ambient Intensity: (%.2f)", m_ambientIntensity), 5.f);
     }
+
+    if (g_theInput->WasKeyJustPressed(KEYCODE_F10))
+    {
+        m_isUpdateGraphSerial = !m_isUpdateGraphSerial;
+        DebugAddMessage(Stringf("Update Graph: %s", m_isUpdateGraphSerial ? "serial" : "parallel"), 5.f);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Keeps where one chunk of m_actors was before this step moves it, so rendering can interpolate toward where it ends up.
+void Map::SavePreviousActorTransforms(int const beginIndex,
+                                      int const endIndex)
+{
+    for (int i = beginIndex; i < endIndex; i++)
+    {
+        m_actors[i]->m_previousPosition    = m_actors[i]->m_position;
+        m_actors[i]->m_previousOrientation = m_actors[i]->m_orientation;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Input is read once per frame but every step integrates only the forces added since the last one, so each player's latched
+// intent is pushed again, unscaled, before each step's integration.
+void Map::ApplyPlayerMoveIntents()
+{
+    for (PlayerController* controller : g_theGame->m_localPlayerControllerList)
+    {
+        Actor const* possessedActor = controller->GetActor();
+
+        if (possessedActor == nullptr) continue;
+
+        AddActorForce(possessedActor->m_handle, controller->m_moveIntent);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// One chunk of the integration of every living actor's body over m_actorBodies. Chunks are whole blocks of slots.
+void Map::IntegrateActorBodies(float const deltaSeconds,
+                               int const   beginSlotIndex,
+                               int const   endSlotIndex)
+{
+    m_actorBodies.IntegrateRange(deltaSeconds, beginSlotIndex, endSlotIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Copies the integrated positions of one chunk of m_actors back to the actors, so the actor updates that follow (AI, cylinders)
+// see where they moved to. Each chunk writes only its own actors.
+void Map::CopyActorBodyPositions(int const beginIndex,
+                                 int const endIndex)
+{
+    for (int i = beginIndex; i < endIndex; i++)
+    {
+        unsigned int const slotIndex = m_actorSlotIndices[i];
+
+        if (!m_actorBodies.HasFlag(slotIndex, ActorBodySet::BODY_SIMULATED)) continue;
+
+        m_actors[i]->m_position = m_actorBodies.GetPosition(slotIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Makes sure every steering chunk has a command buffer before the chunks start, and returns the actor count to steer.
+int Map::PrepareActorCommandBuffers()
+{
+    int const actorCount = static_cast<int>(m_actors.size());
+
+    m_actorCommandBufferCount = JobSystem::GetChunkCount(actorCount, ACTOR_CHUNK_SIZE);
+
+    if (static_cast<int>(m_actorCommandBuffers.size()) < m_actorCommandBufferCount)
+    {
+        m_actorCommandBuffers.resize(m_actorCommandBufferCount);
+    }
+
+    return actorCount;
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::UpdateAllActors(float const deltaSeconds) const
+// AI steering of one chunk of m_actors. Each actor only turns and pushes its own body; firing and path queries are recorded
+// in the chunk's command buffer.
+void Map::SteerActors(float const deltaSeconds,
+                      int const   chunkIndex,
+                      int const   beginIndex,
+                      int const   endIndex)
 {
+    ActorCommandBuffer& commands = m_actorCommandBuffers[chunkIndex];
+    commands.Clear();
+
+    for (int i = beginIndex; i < endIndex; i++)
+    {
+        m_actors[i]->UpdateAI(deltaSeconds, &commands);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// 1. The command buffers filled by SteerActors are executed in chunk order, so deferred effects happen in actor order on any
+//    number of threads.
+// 2. The rest of each actor's update (death, sounds, cylinders) runs serially, as before.
+void Map::UpdateAllActors(float const deltaSeconds)
+{
+    m_deferredCommandCount = 0;
+
+    for (int chunkIndex = 0; chunkIndex < m_actorCommandBufferCount; ++chunkIndex)
+    {
+        ExecuteActorCommands(m_actorCommandBuffers[chunkIndex], deltaSeconds);
+        m_deferredCommandCount += static_cast<int>(m_actorCommandBuffers[chunkIndex].GetCommands().size());
+    }
+
     for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
     {
         if (m_actors[i] != nullptr)
@@ -369,40 +796,111 @@ void Map::UpdateAllActors(float const deltaSeconds) const
     }
 }
 
+//----------------------------------------------------------------------------------------------------
+// Actors may have died or been destroyed by an earlier command, so every command looks its actor up again.
+void Map::ExecuteActorCommands(ActorCommandBuffer const& commands,
+                               float const               deltaSeconds)
+{
+    for (ActorCommand const& command : commands.GetCommands())
+    {
+        Actor* actor = GetActorByHandle(command.m_actorHandle);
+
+        if (actor == nullptr || actor->m_isDead) continue;
+
+        switch (command.m_type)
+        {
+        case eActorCommandType::FIRE_WEAPON:
+            if (actor->m_currentWeapon != nullptr)
+            {
+                actor->m_currentWeapon->Fire();
+                actor->PlayAnimationByName("Attack", true);
+            }
+            break;
+
+        case eActorCommandType::STEER_WITH_PATH:
+            if (actor->m_aiController != nullptr)
+            {
+                actor->m_aiController->Update(deltaSeconds);
+            }
+            break;
+        }
+    }
+}
+
 //----------------------------------------------------------------------------------------------------
 void Map::CollideActors()
 {
+    m_collisionCandidatePairCount = 0;
+    m_collisionOverlapCount       = 0;
+
+    float const maxActorRadius = m_actorGrid.GetMaxActorRadius();
+
     for (int i = 0; i < static_cast<int>(m_actors.size()); ++i)
     {
-        if (m_actors[i] == nullptr || !m_actors[i]->m_handle.IsValid()) continue;
+        unsigned int const slotIndexA = m_actorSlotIndices[i];
 
-        for (int j = i + 1; j < static_cast<int>(m_actors.size()); ++j)
+        if (!m_actorBodies.HasFlag(slotIndexA, ActorBodySet::BODY_COLLIDES_WITH_ACTORS)) continue;
+
+        // Only actors bucketed in cells the two discs could share are candidates.
+        Vec3 const  positionA   = m_actorBodies.GetPosition(slotIndexA);
+        float const queryRadius = m_actorBodies.GetRadius(slotIndexA) + maxActorRadius;
+        Vec2 const  positionXY  = Vec2(positionA.x, positionA.y);
+        AABB2 const queryBounds = AABB2(positionXY - Vec2(queryRadius, queryRadius), positionXY + Vec2(queryRadius, queryRadius));
+
+        m_actorGrid.QueryActorIndices(queryBounds, m_collisionQueryResults);
+
+        for (unsigned int const j : m_collisionQueryResults)
         {
-            if (m_actors[j] == nullptr || !m_actors[j]->m_handle.IsValid()) continue;
+            // Keep the i < j ordering of the all-pairs loop, so each pair is visited once and in the same roles.
+            if (static_cast<int>(j) <= i) continue;
+
+            m_collisionCandidatePairCount++;
 
-            CollideActors(m_actors[i], m_actors[j]);
+            CollideActors(i, static_cast<int>(j));
         }
     }
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::CollideActors(Actor* actorA,
-                        Actor* actorB)
+// Narrow phase on the body arrays; the actors themselves are only visited for pairs whose Z ranges overlap.
+void Map::CollideActors(int const actorIndexA,
+                        int const actorIndexB)
 {
+    unsigned int const slotIndexA = m_actorSlotIndices[actorIndexA];
+    unsigned int const slotIndexB = m_actorSlotIndices[actorIndexB];
+    Vec3 const         positionA  = m_actorBodies.GetPosition(slotIndexA);
+    Vec3 const         positionB  = m_actorBodies.GetPosition(slotIndexB);
+    float const        radiusA    = m_actorBodies.GetRadius(slotIndexA);
+    float const        radiusB    = m_actorBodies.GetRadius(slotIndexB);
+
     // 2. Get actors' MinMaxZ range.
-    FloatRange const actorAMinMaxZ = actorA->m_collisionCylinder.GetFloatRange();
-    FloatRange const actorBMinMaxZ = actorB->m_collisionCylinder.GetFloatRange();
+    FloatRange const actorAMinMaxZ = FloatRange(positionA.z, positionA.z + m_actorBodies.GetHeight(slotIndexA));
+    FloatRange const actorBMinMaxZ = FloatRange(positionB.z, positionB.z + m_actorBodies.GetHeight(slotIndexB));
 
     // 3. If actors are not overlapping on their MinMaxZ range, there will be no collision, so return.
     if (!actorAMinMaxZ.IsOverlappingWith(actorBMinMaxZ)) { return; }
 
+    if (DoDiscsOverlap2D(Vec2(positionA.x, positionA.y), radiusA, Vec2(positionB.x, positionB.y), radiusB))
+    {
+        m_collisionOverlapCount++;
+    }
+
+    Actor* actorA = m_actors[actorIndexA];
+    Actor* actorB = m_actors[actorIndexB];
+
     actorB->OnCollisionEnterWithActor(actorA);
+
+    // 4. The response may have pushed either actor or killed it.
+    UpdateActorBody(*actorA);
+    UpdateActorBody(*actorB);
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::CollideActorsWithMap() const
+// One chunk of m_actors. An actor's map collision reads the tiles and writes only that actor and its body.
+void Map::CollideActorsWithMap(int const beginIndex,
+                               int const endIndex)
 {
-    for (int actorIndex = 0; actorIndex < static_cast<int>(m_actors.size()); ++actorIndex)
+    for (int actorIndex = beginIndex; actorIndex < endIndex; ++actorIndex)
     {
         if (m_actors[actorIndex] != nullptr)
         {
@@ -412,7 +910,7 @@ void Map::CollideActorsWithMap() const
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::CollideActorWithMap(Actor* actor) const
+void Map::CollideActorWithMap(Actor* actor)
 {
     IntVec2 const actorTileCoords = GetTileCoordsFromWorldPos(actor->m_position);
 
@@ -428,7 +926,9 @@ void Map::CollideActorWithMap(Actor* actor) const
     PushActorOutOfTileIfSolid(actor, actorTileCoords + IntVec2(-1, -1));
     PushActorOutOfTileIfSolid(actor, actorTileCoords + IntVec2(1, -1));
 
-    actor->OnCollisionEnterWithMap(GetTile(actorTileCoords)->m_bounds);
+    actor->OnCollisionEnterWithMap(GetTileBounds(actorTileCoords));
+
+    UpdateActorBody(*actor);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -448,24 +948,52 @@ void Map::PushActorOutOfTileIfSolid(Actor*         actor,
 void Map::Render(PlayerController const* toPlayer) const
 {
     RenderAllActors(toPlayer);
-    RenderMap();
+    RenderMap(toPlayer);
 }
 
 //----------------------------------------------------------------------------------------------------
+// Actors and effects are collected into the billboard batcher first, then drawn once per sprite sheet.
 void Map::RenderAllActors(PlayerController const* toPlayer) const
 {
-    for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
+    m_billboardBatcher.BeginView(toPlayer->m_worldCamera->GetCameraToWorldTransform());
+
+    for (Actor const* actor : m_actors)
     {
-        if (m_actors[i] != nullptr)
-        {
-            m_actors[i]->Render(toPlayer);
-        }
+        actor->Render(toPlayer, m_billboardBatcher);
     }
+
+    m_effectSystem->Render(m_billboardBatcher);
+    m_billboardBatcher.EndView(*this);
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::RenderMap() const
+// Chunks outside the player's view frustum are skipped, and the rest are drawn nearest first,
+// so the depth test rejects as much of the farther geometry as possible.
+void Map::RenderMap(PlayerController const* toPlayer) const
 {
+    ViewFrustum const frustum     = toPlayer->GetWorldCameraFrustum();
+    Vec3 const        eyePosition = toPlayer->m_position;
+
+    m_visibleChunkIndices.clear();
+
+    for (int chunkIndex = 0; chunkIndex < static_cast<int>(m_chunks.size()); ++chunkIndex)
+    {
+        MapChunk const& chunk = m_chunks[chunkIndex];
+
+        if (chunk.m_indexCount == 0 || frustum.IsOutside(chunk.m_bounds)) continue;
+
+        m_visibleChunkIndices.push_back(chunkIndex);
+    }
+
+    std::sort(m_visibleChunkIndices.begin(), m_visibleChunkIndices.end(), [this, &eyePosition](int const chunkIndexA, int const chunkIndexB)
+    {
+        AABB3 const& boundsA = m_chunks[chunkIndexA].m_bounds;
+        AABB3 const& boundsB = m_chunks[chunkIndexB].m_bounds;
+
+        return GetDistanceSquared3D(eyePosition, (boundsA.m_mins + boundsA.m_maxs) * 0.5f) <
+               GetDistanceSquared3D(eyePosition, (boundsB.m_mins + boundsB.m_maxs) * 0.5f);
+    });
+
     g_theRenderer->SetModelConstants();
     g_theRenderer->SetLightConstants(m_sunDirection, m_sunIntensity, m_ambientIntensity);
     g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
@@ -475,7 +1003,13 @@ void Map::RenderMap() const
     g_theRenderer->BindTexture(m_texture);
     g_theRenderer->BindShader(m_shader);
 
-    g_theRenderer->DrawVertexArray(m_vertexes, m_indexes);
+    for (int const chunkIndex : m_visibleChunkIndices)
+    {
+        MapChunk const& chunk = m_chunks[chunkIndex];
+
+        g_theRenderer->DrawIndexedVertexBuffer(chunk.m_vertexBuffer, chunk.m_indexBuffer, chunk.m_indexCount);
+        g_renderStats.AddDrawCall();
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -488,13 +1022,9 @@ RaycastResult3D Map::RaycastAll(Vec3 const& startPosition,
 
     IntVec2 startTileCoords = GetTileCoordsFromWorldPos(startPosition);
 
-    if (!IsTileCoordsOutOfBounds(startTileCoords))
+    if (IsTileSolid(startTileCoords))
     {
-        Tile const* startTile       = GetTile(startTileCoords);
-        AABB3 const startTileBounds = startTile->m_bounds;
-
-        if (startTileBounds.IsPointInside(startPosition) &&
-            startTile->m_isSolid)
+        if (GetTileBounds(startTileCoords).IsPointInside(startPosition))
         {
             closestResult.m_didImpact      = false;
             closestResult.m_impactPosition = startPosition;
@@ -538,7 +1068,24 @@ RaycastResult3D Map::RaycastAll(Actor const* attackerActor,
                                 ActorHandle& out_impactedActorHandle,
                                 Vec3 const&  startPosition,
                                 Vec3 const&  forwardNormal,
-                                float        maxLength) const
+                                float const  maxLength) const
+{
+    RaycastResult3D closestResult;
+
+    RaycastBatch(attackerActor, startPosition, &forwardNormal, 1, maxLength, &closestResult, &out_impactedActorHandle);
+
+    return closestResult;
+}
+
+//----------------------------------------------------------------------------------------------------
+// RaycastAll with the actors rewound to viewTimeSeconds (GetSimulationSeconds), e.g. the time the shooter saw when firing.
+// Walls, floor and ceiling are tested as they are now; actors come from m_actorHistory, interpolated between recorded ticks.
+RaycastResult3D Map::RaycastAllAtTime(Actor const* attackerActor,
+                                      ActorHandle& out_impactedActorHandle,
+                                      Vec3 const&  startPosition,
+                                      Vec3 const&  forwardNormal,
+                                      float const  maxLength,
+                                      double const viewTimeSeconds) const
 {
     RaycastResult3D closestResult;
     closestResult.m_didImpact        = false;
@@ -550,25 +1097,15 @@ RaycastResult3D Map::RaycastAll(Actor const* attackerActor,
     closestResult.m_rayMaxLength     = maxLength;
     float closestLength              = maxLength;
 
-    IntVec2 startTileCoords = GetTileCoordsFromWorldPos(startPosition);
+    IntVec2 const startTileCoords = GetTileCoordsFromWorldPos(startPosition);
 
-    if (!IsTileCoordsOutOfBounds(startTileCoords))
+    if (IsTileSolid(startTileCoords) &&
+        GetTileBounds(startTileCoords).IsPointInside(startPosition))
     {
-        Tile const* startTile       = GetTile(startTileCoords);
-        AABB3 const startTileBounds = startTile->m_bounds;
-
-        if (startTileBounds.IsPointInside(startPosition) &&
-            startTile->m_isSolid)
-        {
-            closestResult.m_didImpact      = false;
-            closestResult.m_impactPosition = startPosition;
-            closestResult.m_impactNormal   = -closestResult.m_rayForwardNormal;
-
-            return closestResult;
-        }
+        return closestResult;
     }
 
-    RaycastResult3D xyResult = RaycastWorldXY(startPosition, forwardNormal, maxLength);
+    RaycastResult3D const xyResult = RaycastWorldXY(startPosition, forwardNormal, maxLength);
 
     if (xyResult.m_didImpact &&
         xyResult.m_impactLength < closestLength)
@@ -577,7 +1114,7 @@ RaycastResult3D Map::RaycastAll(Actor const* attackerActor,
         closestLength = xyResult.m_impactLength;
     }
 
-    RaycastResult3D zResult = RaycastWorldZ(startPosition, forwardNormal, maxLength);
+    RaycastResult3D const zResult = RaycastWorldZ(startPosition, forwardNormal, maxLength);
 
     if (zResult.m_didImpact &&
         zResult.m_impactLength < closestLength)
@@ -586,7 +1123,8 @@ RaycastResult3D Map::RaycastAll(Actor const* attackerActor,
         closestLength = zResult.m_impactLength;
     }
 
-    RaycastResult3D actorResult = RaycastWorldActors(attackerActor, out_impactedActorHandle, startPosition, forwardNormal, maxLength);
+    ActorHandle const     ignoredHandle = attackerActor != nullptr ? attackerActor->m_handle : ActorHandle::INVALID;
+    RaycastResult3D const actorResult   = m_actorHistory.RaycastActorsAtTime(viewTimeSeconds, startPosition, forwardNormal, maxLength, ignoredHandle, out_impactedActorHandle);
 
     if (actorResult.m_didImpact &&
         actorResult.m_impactLength < closestLength)
@@ -599,62 +1137,94 @@ RaycastResult3D Map::RaycastAll(Actor const* attackerActor,
 }
 
 //----------------------------------------------------------------------------------------------------
-RaycastResult3D Map::RaycastWorldXY(Vec3 const& startPosition,
-                                    Vec3 const& forwardNormal,
-                                    float const maxLength) const
+// RaycastAll for several rays from one start position, e.g. the pellets of one shot.
+// The start-tile check runs once and the actors are tested for the whole batch in one pass over the cylinder mirror;
+// the XY march and the Z planes stay per ray. Each entry of out_results and out_impactedActorHandles
+// (both rayCount long, owned by the caller) matches what RaycastAll returns for that ray alone.
+// The actor pass writes straight into out_results, which then serves as the only scratch, so the query keeps no state.
+void Map::RaycastBatch(Actor const*     attackerActor,
+                       Vec3 const&      startPosition,
+                       Vec3 const*      forwardNormals,
+                       int const        rayCount,
+                       float const      maxLength,
+                       RaycastResult3D* out_results,
+                       ActorHandle*     out_impactedActorHandles) const
 {
-    // 1. Initialize raycastResult3D.
-    RaycastResult3D result;
-    result.m_rayStartPosition = startPosition;
-    result.m_rayForwardNormal = forwardNormal;
-    result.m_rayMaxLength     = maxLength;
+    // 1. Every ray starts as a miss at full length.
+    auto const setMiss = [&](int const rayIndex)
+    {
+        RaycastResult3D& result = out_results[rayIndex];
+
+        result                    = RaycastResult3D();
+        result.m_didImpact        = false;
+        result.m_impactPosition   = startPosition;
+        result.m_impactNormal     = -forwardNormals[rayIndex];
+        result.m_impactLength     = maxLength;
+        result.m_rayStartPosition = startPosition;
+        result.m_rayForwardNormal = forwardNormals[rayIndex];
+        result.m_rayMaxLength     = maxLength;
+    };
+
+    for (int rayIndex = 0; rayIndex < rayCount; ++rayIndex)
+    {
+        setMiss(rayIndex);
+    }
+
+    // 2. A start inside a wall stops every ray where it is.
+    IntVec2 const startTileCoords = GetTileCoordsFromWorldPos(startPosition);
 
-    // 2. Calculate information for the ray's stepping while-loop.
-    Vec3             currentPosition   = startPosition;
-    float            currentLength     = 0.f;
-    float constexpr  stepSize          = 0.01f;
-    Vec3 const       rayMoveStep       = forwardNormal * stepSize;
-    float const      rayMoveStepLength = rayMoveStep.GetLength();
-    FloatRange const rangeWorldZ       = FloatRange(0.f, 1.f);
+    if (IsTileSolid(startTileCoords) &&
+        GetTileBounds(startTileCoords).IsPointInside(startPosition))
+    {
+        return;
+    }
 
-    // 3. While the ray is still stepping forward,
-    while (currentLength < maxLength)
+    // 3. Actors for the whole batch, into the caller's results.
+    RaycastWorldActorsBatch(attackerActor, startPosition, forwardNormals, rayCount, maxLength, out_results, out_impactedActorHandles);
+
+    // 4. Walls, then floor and ceiling, then actors, keeping the closest, in the same order as a single RaycastAll.
+    for (int rayIndex = 0; rayIndex < rayCount; ++rayIndex)
     {
-        // 4. Step the ray forward.
-        currentPosition += rayMoveStep;
-        currentLength += rayMoveStepLength;
+        RaycastResult3D const actorResult = out_results[rayIndex];
 
-        // 5. If the current tile is not in the map, continue the loop.
-        IntVec2 currentTileCoords = GetTileCoordsFromWorldPos(currentPosition);
+        setMiss(rayIndex);
 
-        if (IsTileCoordsOutOfBounds(currentTileCoords)) { continue; }
+        RaycastResult3D& closestResult = out_results[rayIndex];
+        float            closestLength = maxLength;
 
-        Tile const* currentTile         = GetTile(currentTileCoords);
-        AABB3 const currentTileBounds3D = currentTile->m_bounds;
-        AABB2 const currentTileBounds2D = AABB2(Vec2(currentTileBounds3D.m_mins.x, currentTileBounds3D.m_mins.y), Vec2(currentTileBounds3D.m_maxs.x, currentTileBounds3D.m_maxs.y));
-        Vec3 const  previousPosition    = currentPosition - forwardNormal * rayMoveStepLength;
-        Vec2 const  previousPositionXY  = Vec2(previousPosition.x, previousPosition.y);
+        RaycastResult3D const xyResult = RaycastWorldXY(startPosition, forwardNormals[rayIndex], maxLength);
 
-        if (IsTileSolid(currentTileCoords) &&
-            rangeWorldZ.IsOnRange(currentPosition.z) &&
-            !currentTileBounds2D.IsPointInside(previousPositionXY))
+        if (xyResult.m_didImpact &&
+            xyResult.m_impactLength < closestLength)
         {
-            result.m_didImpact         = true;
-            result.m_impactPosition    = currentPosition;
-            IntVec2 const impactNormal = GetTileCoordsFromWorldPos(previousPosition) - GetTileCoordsFromWorldPos(currentPosition);
-            result.m_impactNormal      = Vec3(impactNormal.x, impactNormal.y, 0);
-            result.m_impactLength      = currentLength;
+            closestResult = xyResult;
+            closestLength = xyResult.m_impactLength;
+        }
 
-            return result;
+        RaycastResult3D const zResult = RaycastWorldZ(startPosition, forwardNormals[rayIndex], maxLength);
+
+        if (zResult.m_didImpact &&
+            zResult.m_impactLength < closestLength)
+        {
+            closestResult = zResult;
+            closestLength = zResult.m_impactLength;
         }
-    }
 
-    result.m_didImpact      = false;
-    result.m_impactPosition = startPosition;
-    result.m_impactNormal   = -forwardNormal;
-    result.m_impactLength   = 0.f;
+        if (actorResult.m_didImpact &&
+            actorResult.m_impactLength < closestLength)
+        {
+            closestResult = actorResult;
+            closestLength = actorResult.m_impactLength;
+        }
+    }
+}
 
-    return result;
+//----------------------------------------------------------------------------------------------------
+RaycastResult3D Map::RaycastWorldXY(Vec3 const& startPosition,
+                                    Vec3 const& forwardNormal,
+                                    float const maxLength) const
+{
+    return m_occupancyPyramid.RaycastXY(startPosition, forwardNormal, maxLength);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -712,123 +1282,354 @@ RaycastResult3D Map::RaycastWorldActors(Actor const* attackerActor,
                                         Vec3 const&  forwardNormal,
                                         float const  maxLength) const
 {
-    RaycastResult3D closestResult;
-    out_impactedActorHandle = ActorHandle::INVALID;
-    float closestDistance   = maxLength;
+    ActorHandle const ignoredHandle = attackerActor != nullptr ? attackerActor->m_handle : ActorHandle::INVALID;
 
-    for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
+    return m_actorCylinders.RaycastClosest(startPosition, forwardNormal, maxLength, ignoredHandle, out_impactedActorHandle);
+}
+
+//----------------------------------------------------------------------------------------------------
+RaycastResult3D Map::RaycastWorldActors(Vec3 const& startPosition,
+                                        Vec3 const& forwardNormal,
+                                        float const maxLength) const
+{
+    ActorHandle out_impactedActorHandle;
+
+    return m_actorCylinders.RaycastClosest(startPosition, forwardNormal, maxLength, ActorHandle::INVALID, out_impactedActorHandle);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Several rays from one start position (a shotgun volley) in one pass over the cylinders.
+// Each ray gets the same result and handle the single-ray RaycastWorldActors would return.
+void Map::RaycastWorldActorsBatch(Actor const*     attackerActor,
+                                  Vec3 const&      startPosition,
+                                  Vec3 const*      forwardNormals,
+                                  int const        rayCount,
+                                  float const      maxLength,
+                                  RaycastResult3D* out_results,
+                                  ActorHandle*     out_impactedActorHandles) const
+{
+    ActorHandle const ignoredHandle = attackerActor != nullptr ? attackerActor->m_handle : ActorHandle::INVALID;
+
+    m_actorCylinders.RaycastClosestBatch(startPosition, forwardNormals, rayCount, maxLength, ignoredHandle, out_results, out_impactedActorHandles);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Every actor along the ray, up to the first wall, floor or ceiling, sorted by distance into the caller's out_hits.
+// The ray walks the tile grid once with the same TileRayWalker as RaycastWorldXY; each tile it enters pulls the actors of the
+// cells within GetMaxActorRadius() of it from m_actorGrid, so cylinders that overhang a neighbouring cell are still found.
+// The grid and m_actorCylinders both hold only the actors that collide with actors, so this hits the same actors as RaycastAll.
+// An actor found from several tiles is tested again and skipped if out_hits already has it, so the query needs no scratch
+// and never allocates. When more than maxHitCount intersections exist, the nearest ones are kept. The blocking world hit,
+// if any, comes last with an INVALID handle. Returns the number of hits written.
+int Map::RaycastPenetrating(Actor const* const attackerActor,
+                            Vec3 const&        startPosition,
+                            Vec3 const&        forwardNormal,
+                            float const        maxLength,
+                            RaycastHit* const  out_hits,
+                            int const          maxHitCount) const
+{
+    if (maxHitCount <= 0) return 0;
+
+    // 1. A start inside a wall sees nothing.
+    IntVec2 const startTileCoords = GetTileCoordsFromWorldPos(startPosition);
+
+    if (IsTileSolid(startTileCoords) &&
+        GetTileBounds(startTileCoords).IsPointInside(startPosition))
     {
-        if (m_actors[i] == nullptr) continue;
-        if (attackerActor == m_actors[i]) continue;
+        return 0;
+    }
 
-        Cylinder3             cylinder3 = m_actors[i]->m_collisionCylinder;
-        RaycastResult3D const result    = RaycastVsCylinderZ3D(startPosition,
-                                                               forwardNormal, maxLength,
-                                                               cylinder3.GetCenterPositionXY(),
-                                                               cylinder3.GetFloatRange(),
-                                                               cylinder3.m_radius);
+    // 2. The floor or ceiling caps the walk; a wall found during the walk caps it further.
+    RaycastResult3D blockingResult = RaycastWorldZ(startPosition, forwardNormal, maxLength);
+    float           stopLength     = blockingResult.m_didImpact ? blockingResult.m_impactLength : maxLength;
 
+    ActorHandle const ignoredHandle = attackerActor != nullptr ? attackerActor->m_handle : ActorHandle::INVALID;
+    float const       queryPadding  = m_actorGrid.GetMaxActorRadius();
+    int               hitCount      = 0;
 
-        if (result.m_didImpact &&
-            result.m_impactLength < closestDistance)
+    // 3. Test the actors around one tile, inserting hits in distance order and dropping the farthest once the buffer is full.
+    auto const gatherActorsAround = [&](IntVec2 const& tileCoords)
+    {
+        AABB2 const queryBounds(Vec2(static_cast<float>(tileCoords.x) - queryPadding, static_cast<float>(tileCoords.y) - queryPadding),
+                                Vec2(static_cast<float>(tileCoords.x + 1) + queryPadding, static_cast<float>(tileCoords.y + 1) + queryPadding));
+
+        IntVec2 const minCellCoords = m_actorGrid.GetCellCoords(queryBounds.m_mins);
+        IntVec2 const maxCellCoords = m_actorGrid.GetCellCoords(queryBounds.m_maxs);
+
+        for (int cellY = minCellCoords.y; cellY <= maxCellCoords.y; ++cellY)
+        {
+            for (int cellX = minCellCoords.x; cellX <= maxCellCoords.x; ++cellX)
+            {
+                unsigned int const* cellEntries    = nullptr;
+                int const           cellEntryCount = m_actorGrid.GetCellActorIndices(m_actorGrid.GetCellIndex(cellX, cellY), cellEntries);
+
+                for (int entryIndex = 0; entryIndex < cellEntryCount; ++entryIndex)
+                {
+                    unsigned int const actorIndex  = cellEntries[entryIndex];
+                    ActorHandle const  actorHandle = m_actorCylinders.GetHandle(actorIndex);
+
+                    if (!actorHandle.IsValid() || actorHandle == ignoredHandle) continue;
+
+                    RaycastResult3D const result = m_actorCylinders.RaycastActor(actorIndex, startPosition, forwardNormal, maxLength);
+
+                    if (!result.m_didImpact || result.m_impactLength >= stopLength) continue;
+                    if (hitCount == maxHitCount && result.m_impactLength >= out_hits[hitCount - 1].m_result.m_impactLength) continue;
+
+                    bool isAlreadyHit = false;
+
+                    for (int hitIndex = 0; hitIndex < hitCount && !isAlreadyHit; ++hitIndex)
+                    {
+                        isAlreadyHit = out_hits[hitIndex].m_actorHandle == actorHandle;
+                    }
+
+                    if (isAlreadyHit) continue;
+
+                    int insertIndex = hitCount < maxHitCount ? hitCount++ : hitCount - 1;
+
+                    while (insertIndex > 0 && out_hits[insertIndex - 1].m_result.m_impactLength > result.m_impactLength)
+                    {
+                        out_hits[insertIndex] = out_hits[insertIndex - 1];
+                        insertIndex--;
+                    }
+
+                    out_hits[insertIndex].m_result      = result;
+                    out_hits[insertIndex].m_actorHandle = actorHandle;
+                }
+            }
+        }
+    };
+
+    // 4. Walk the tiles until the ray passes stopLength or enters a wall within the wall height.
+    FloatRange const rangeWorldZ = FloatRange(0.f, 1.f);
+    TileRayWalker    walker(startPosition, forwardNormal);
+    bool             isStartTile = true;
+
+    walker.Walk(stopLength, [&](TileRayWalker const& tile)
+    {
+        IntVec2 const tileCoords = tile.GetTileCoords();
+
+        if (!isStartTile && !IsTileCoordsOutOfBounds(tileCoords) && IsTileSolid(tileCoords))
         {
-            closestResult           = result;
-            closestDistance         = result.m_impactLength;
-            out_impactedActorHandle = m_actors[i]->m_handle;
+            Vec3 const impactPosition = startPosition + forwardNormal * tile.GetEntryLength();
+
+            if (rangeWorldZ.IsOnRange(impactPosition.z))
+            {
+                IntVec2 const impactNormal = tile.GetEntryNormal();
+
+                blockingResult.m_didImpact      = true;
+                blockingResult.m_impactPosition = impactPosition;
+                blockingResult.m_impactNormal   = Vec3(static_cast<float>(impactNormal.x), static_cast<float>(impactNormal.y), 0.f);
+                blockingResult.m_impactLength   = tile.GetEntryLength();
+                stopLength                      = tile.GetEntryLength();
+                return false;
+            }
         }
+
+        gatherActorsAround(tileCoords);
+        isStartTile = false;
+        return true;
+    });
+
+    // 5. Actors gathered before the wall was found may still lie behind it.
+    while (hitCount > 0 && out_hits[hitCount - 1].m_result.m_impactLength >= stopLength)
+    {
+        hitCount--;
     }
 
-    return closestResult;
+    if (blockingResult.m_didImpact && hitCount < maxHitCount)
+    {
+        out_hits[hitCount].m_result      = blockingResult;
+        out_hits[hitCount].m_actorHandle = ActorHandle::INVALID;
+        hitCount++;
+    }
+
+    return hitCount;
 }
 
+//----------------------------------------------------------------------------------------------------
+// Set by Game after the frame's simulation steps: 0 renders actors where the last step started, 1 where it ended.
+void Map::SetInterpolationFraction(float const fraction)
+{
+    m_interpolationFraction = GetClampedZeroToOne(fraction);
+}
 
 //----------------------------------------------------------------------------------------------------
-RaycastResult3D Map::RaycastWorldActors(Vec3 const& startPosition,
-                                        Vec3 const& forwardNormal,
-                                        float const maxLength) const
+float Map::GetInterpolationFraction() const
 {
-    RaycastResult3D closestResult;
-    float           closestDistance = maxLength;
+    return m_interpolationFraction;
+}
 
-    for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
-    {
-        Cylinder3             cylinder3 = m_actors[i]->m_collisionCylinder;
-        RaycastResult3D const result    = RaycastVsCylinderZ3D(startPosition,
-                                                               forwardNormal, maxLength,
-                                                               cylinder3.GetCenterPositionXY(),
-                                                               cylinder3.GetFloatRange(),
-                                                               cylinder3.m_radius);
+//----------------------------------------------------------------------------------------------------
+double Map::GetSimulationSeconds() const
+{
+    return m_simulationSeconds;
+}
 
-        if (result.m_didImpact &&
-            result.m_impactLength < closestDistance)
-        {
-            closestResult   = result;
-            closestDistance = result.m_impactLength;
-        }
+//----------------------------------------------------------------------------------------------------
+unsigned int Map::GetTickIndex() const
+{
+    return m_tickIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned int Map::GetRandomSeed() const
+{
+    return m_randomSeed;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Main thread only. Keyed past the largest actor handle, so it never repeats an actor's stream.
+RandomStream& Map::GetRandomStream()
+{
+    if (!m_randomStream.IsKeyedForTick(m_tickIndex))
+    {
+        m_randomStream.Reset(m_randomSeed, 0xffffffffu, m_tickIndex);
     }
 
-    return closestResult;
+    return m_randomStream;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Called whenever an actor's collision cylinder changes, so raycasts later in the same frame see where it is now.
+void Map::UpdateActorCylinder(Actor const& actor)
+{
+    Actor const* slotActor = GetActorByHandle(actor.m_handle);
+
+    if (slotActor != &actor) return;
+
+    m_actorCylinders.SetCylinder(m_actorSlots[actor.m_handle.GetIndex()].m_denseIndex, actor);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Called whenever an actor moves itself (collision push-outs) or dies, so the body arrays stay in step with the actor.
+void Map::UpdateActorBody(Actor const& actor)
+{
+    Actor const* slotActor = GetActorByHandle(actor.m_handle);
+
+    if (slotActor != &actor) return;
+
+    unsigned int const slotIndex = actor.m_handle.GetIndex();
+
+    m_actorBodies.SetPosition(slotIndex, actor.m_position);
+    m_actorBodies.SetFlag(slotIndex, ActorBodySet::BODY_SIMULATED, !actor.m_isDead);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Map::AddActorForce(ActorHandle const& handle,
+                        Vec3 const&        force)
+{
+    if (GetActorByHandle(handle) == nullptr) return;
+
+    m_actorBodies.AddForce(handle.GetIndex(), force);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Map::AddActorImpulse(ActorHandle const& handle,
+                          Vec3 const&        impulse)
+{
+    if (GetActorByHandle(handle) == nullptr) return;
+
+    m_actorBodies.AddImpulse(handle.GetIndex(), impulse);
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 Map::GetActorVelocity(ActorHandle const& handle) const
+{
+    if (GetActorByHandle(handle) == nullptr) return Vec3::ZERO;
+
+    return m_actorBodies.GetVelocity(handle.GetIndex());
 }
 
 //----------------------------------------------------------------------------------------------------
 // Spawn a specified actor according to the provided spawn info.
-// Should find or add a slot in our actor list, increment our next uid, generate a handle, and construct and return the actor.
+// Reuse a free slot if there is one, otherwise grow the slot list, then generate a handle from the slot's generation
+// and append the actor to the dense live list.
 Actor* Map::SpawnActor(SpawnInfo const& spawnInfo)
 {
-    if (m_nextActorUID >= MAX_ACTOR_UID)
+    unsigned int slotIndex;
+
+    if (!m_freeActorSlotIndices.empty())
     {
-        return nullptr;
+        slotIndex = m_freeActorSlotIndices.back();
+        m_freeActorSlotIndices.pop_back();
+    }
+    else
+    {
+        if (m_actorSlots.size() >= MAX_ACTOR_SLOT_COUNT)
+        {
+            return nullptr;
+        }
+
+        slotIndex = static_cast<unsigned int>(m_actorSlots.size());
+        m_actorSlots.emplace_back();
     }
 
-    unsigned int const newIndex = static_cast<unsigned int>(m_actors.size());
-    Actor*             newActor = new Actor(spawnInfo);
+    Actor* newActor = new Actor(spawnInfo);
+
+    ActorSlot& slot    = m_actorSlots[slotIndex];
+    slot.m_actor       = newActor;
+    slot.m_denseIndex  = static_cast<unsigned int>(m_actors.size());
+    newActor->m_handle = ActorHandle(slot.m_generation, slotIndex);
+    newActor->m_map    = this;
+    m_actors.push_back(newActor);
+    m_actorSlotIndices.push_back(slotIndex);
+    m_actorCylinders.SetCylinder(slot.m_denseIndex, *newActor);
+
+    ActorDefinition const* definition = newActor->m_definition;
+    uint8_t                bodyFlags  = 0;
 
-    ActorHandle const handle = ActorHandle(m_nextActorUID, newIndex);
-    newActor->m_handle       = handle;
-    newActor->m_map          = this;
+    if (!definition->m_dieOnSpawn) bodyFlags |= ActorBodySet::BODY_SIMULATED;
+    if (definition->m_collidesWithActors) bodyFlags |= ActorBodySet::BODY_COLLIDES_WITH_ACTORS;
+    if (!definition->m_flying) bodyFlags |= ActorBodySet::BODY_PINNED_TO_FLOOR;
+
+    m_actorBodies.AddBody(slotIndex, newActor->m_position, spawnInfo.m_velocity, newActor->m_radius, newActor->m_height, definition->m_drag, bodyFlags);
 
     newActor->m_aiController = new AIController(this);
     newActor->m_controller   = newActor->m_aiController;
     newActor->m_aiController->Possess(newActor->m_handle);
 
-
-    m_actors.push_back(newActor);
-    m_nextActorUID++;
+    if (newActor->m_definition->m_aiEnabled)
+    {
+        m_aiScheduler.RegisterActor(newActor->m_handle);
+    }
 
     return newActor;
 }
 
+//----------------------------------------------------------------------------------------------------
+// Spawn a short-lived visual effect (e.g. BulletHit, BloodSplatter) that plays its definition's death animation.
+// Effects are not actors, so they have no handle and cannot be collided with, damaged or possessed.
+bool Map::SpawnEffect(String const& definitionName,
+                      Vec3 const&   position) const
+{
+    return m_effectSystem->SpawnEffect(definitionName, position);
+}
+
 //----------------------------------------------------------------------------------------------------
 // Dereference an actor handle and return an actor pointer.
-// Get the index from the actor handle.
-// If that slot in our list of actors is null, return null.
-// If that slot in our list of actors contains an actor, check if that actor’s handle matches the input actor handle.
-// If they do not match, return null.
-// Otherwise, return the actor pointer at that index.
+// Get the slot from the actor handle's index.
+// If that slot is empty, or its generation does not match the handle's generation, return null.
+// Otherwise, return the actor pointer in that slot.
 Actor* Map::GetActorByHandle(ActorHandle const handle) const
 {
     if (!handle.IsValid()) { return nullptr; }
 
     unsigned int const handleIndex = handle.GetIndex();
 
-    if (handleIndex >= m_actors.size())
+    if (handleIndex >= m_actorSlots.size())
     {
         return nullptr;
     }
 
-    Actor* storedActor = m_actors[handleIndex];
-
-    if (storedActor == nullptr)
-    {
-        return nullptr;
-    }
+    ActorSlot const& slot = m_actorSlots[handleIndex];
 
-    if (storedActor->m_handle != handle)
+    if (slot.m_actor == nullptr ||
+        slot.m_generation != handle.GetGeneration())
     {
         return nullptr;
     }
 
-    return storedActor;
+    return slot.m_actor;
 }
 
 Actor const* Map::GetActorByName(String const& name) const
@@ -865,18 +1666,36 @@ void Map::GetActorsByName(std::vector<Actor*>& out_ActorList, String const& name
 
 //----------------------------------------------------------------------------------------------------
 // Delete any actors marked as destroyed.
+// The live list is compacted in place, so it stays dense and keeps its spawn order.
+// Each freed slot bumps its generation and goes on the free list.
 void Map::DeleteDestroyedActor()
 {
+    unsigned int liveCount = 0;
+
     for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
     {
-        if (m_actors[i] == nullptr) continue;
-        if (!m_actors[i]->m_handle.IsValid()) continue;
-        if (!m_actors[i]->m_isGarbage) continue;
+        Actor*             actor     = m_actors[i];
+        unsigned int const slotIndex = actor->m_handle.GetIndex();
+        ActorSlot&         slot      = m_actorSlots[slotIndex];
 
-        unsigned int const index = m_actors[i]->m_handle.GetIndex();
-        delete m_actors[i];
-        m_actors[index] = nullptr;
+        if (!actor->m_isGarbage)
+        {
+            slot.m_denseIndex             = liveCount;
+            m_actorSlotIndices[liveCount] = slotIndex;
+            m_actors[liveCount++]         = actor;
+            continue;
+        }
+
+        delete actor;
+        m_actorBodies.RemoveBody(slotIndex);
+
+        slot.m_actor      = nullptr;
+        slot.m_generation = slot.m_generation >= ActorHandle::MAX_GENERATION ? 0 : slot.m_generation + 1;
+        m_freeActorSlotIndices.push_back(slotIndex);
     }
+
+    m_actors.resize(liveCount);
+    m_actorSlotIndices.resize(liveCount);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -887,79 +1706,187 @@ Actor* Map::SpawnPlayer(PlayerController* playerController)
     spawnInfo.m_name = "Marine";
     std::vector<Actor*> out_actorLists;
     GetActorsByName(out_actorLists, "SpawnPoint");
-    Actor const* spawnPoint = out_actorLists[g_theRNG->RollRandomIntInRange(0, (int)out_actorLists.size() - 1)];
+    Actor const* spawnPoint = out_actorLists[GetRandomStream().RollRandomIntInRange(0, (int)out_actorLists.size() - 1)];
     spawnInfo.m_position    = spawnPoint->m_position;
     spawnInfo.m_orientation = spawnPoint->m_orientation;
-    spawnInfo.m_velocity    = spawnPoint->m_velocity;
     Actor* playerActor      = SpawnActor(spawnInfo);
     playerController->m_map = this;
     return playerActor;
 }
 
 //----------------------------------------------------------------------------------------------------
-// Search the actor list to find actors meeting the provided criteria.
-Actor const* Map::GetClosestVisibleEnemy(Actor const* owner) const
+// Perception query: candidates come from the actor grid cells inside the owner's sight radius,
+// the FOV test is a dot product against the definition's precomputed cosine, and only the survivors are raycast,
+// nearest first, stopping at the first one in line of sight.
+// Only actors in the grid (those that collide with actors) can be seen; every faction-bearing actor does.
+// Runs on the perception task's thread, so it only writes the caller's scratch and reads the map.
+Actor const* Map::GetClosestVisibleEnemy(Actor const*       owner,
+                                         PerceptionScratch& scratch) const
 {
-    float        closestDistanceSquared = FLOAT_MAX;
-    Actor const* closestEnemy           = nullptr;
+    ActorDefinition const* ownerDef = owner->m_definition;
 
-    for (Actor const* actor : m_actors)
+    // Neutral actors have no enemies.
+    if (ownerDef->m_faction == "NEUTRAL") return nullptr;
+
+    float const sightRadius        = ownerDef->m_sightRadius;
+    float const sightRadiusSquared = sightRadius * sightRadius;
+    Vec2 const  ownerPositionXY    = Vec2(owner->m_position.x, owner->m_position.y);
+    Vec2 const  forwardXY          = Vec2(CosDegrees(owner->m_orientation.m_yawDegrees), SinDegrees(owner->m_orientation.m_yawDegrees));
+    AABB2 const queryBounds        = AABB2(ownerPositionXY - Vec2(sightRadius, sightRadius), ownerPositionXY + Vec2(sightRadius, sightRadius));
+
+    // 1. Broadphase: only actors bucketed within the sight radius.
+    m_actorGrid.QueryActorIndices(queryBounds, scratch.m_actorIndices);
+    scratch.m_candidates.clear();
+
+    for (unsigned int const actorIndex : scratch.m_actorIndices)
     {
+        Actor const* actor = m_actors[actorIndex];
+
         if (actor == nullptr || actor == owner) continue;
 
-        // Skip same faction or neutral
-        if (actor->m_definition->m_faction == owner->m_definition->m_faction) continue;
-        if (actor->m_definition->m_faction == "NEUTRAL"
-            || owner->m_definition->m_faction == "NEUTRAL")
-        {
-            continue;
-        }
+        // 2. Distance, then the FOV cone without an acos.
+        Vec2 const  toActorXY       = Vec2(actor->m_position.x, actor->m_position.y) - ownerPositionXY;
+        float const distanceSquared = toActorXY.x * toActorXY.x + toActorXY.y * toActorXY.y;
 
-        // Check distance
-        Vec2 actorPositionXY      = Vec2(actor->m_position.x, actor->m_position.y);
-        Vec2 instigatorPositionXY = Vec2(owner->m_position.x, owner->m_position.y);
+        if (distanceSquared > sightRadiusSquared) continue;
 
-        float const distanceSquared = GetDistanceSquared2D(actorPositionXY, instigatorPositionXY);
-        float const radiusSquared   = owner->m_definition->m_sightRadius * owner->m_definition->m_sightRadius;
+        float const forwardDot = forwardXY.x * toActorXY.x + forwardXY.y * toActorXY.y;
 
-        if (distanceSquared > radiusSquared)
-        {
-            continue; // too far
-        }
+        if (forwardDot < ownerDef->m_sightCosine * sqrtf(distanceSquared)) continue;
 
-        // Check angle
-        Vec3 forward, left, up;
-        owner->m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+        // 3. Faction last, since it is the only string compare.
+        if (actor->m_definition->m_faction == ownerDef->m_faction) continue;
+        if (actor->m_definition->m_faction == "NEUTRAL") continue;
 
-        Vec3 direction3D = actor->GetActorEyePosition() - owner->GetActorEyePosition();
+        scratch.m_candidates.push_back(PerceptionCandidate{ distanceSquared, actor });
+    }
 
-        Vec2 fwd2D(forward.x, forward.y);
-        Vec2 dirToActor = (actorPositionXY - instigatorPositionXY).GetNormalized();
+    // 4. Line of sight, nearest first: pairs the PVS knows are blocked skip the ray, and the first candidate the ray actually reaches is the closest visible enemy.
+    std::sort(scratch.m_candidates.begin(), scratch.m_candidates.end(),
+              [](PerceptionCandidate const& a, PerceptionCandidate const& b) { return a.m_distanceSquared < b.m_distanceSquared; });
 
-        // The angle between forward vector and direction to the actor
-        float const angleBetween = GetAngleDegreesBetweenVectors2D(fwd2D, dirToActor);
+    Vec3 const    ownerEyePosition = owner->GetActorEyePosition();
+    IntVec2 const ownerTileCoords  = GetTileCoordsFromWorldPos(owner->m_position);
 
-        if (angleBetween > owner->m_definition->m_sightAngle * 0.5f)
-        {
-            continue; // out of FOV cone
-        }
+    for (PerceptionCandidate const& candidate : scratch.m_candidates)
+    {
+        Actor const* actor = candidate.m_actor;
+
+        if (!m_visibilitySet.IsPotentiallyVisible(ownerTileCoords, GetTileCoordsFromWorldPos(actor->m_position), m_solidityVersion)) continue;
+
+        Vec3 const direction3D = actor->GetActorEyePosition() - ownerEyePosition;
 
-        /// Line of Sight check: make sure no walls blocking
         ActorHandle           out_impactedActorHandle;
-        RaycastResult3D const result = RaycastAll(owner, out_impactedActorHandle, owner->GetActorEyePosition(), direction3D.GetNormalized(), distanceSquared);
+        RaycastResult3D const result = RaycastAll(owner, out_impactedActorHandle, ownerEyePosition, direction3D.GetNormalized(), direction3D.GetLength());
 
         if (!result.m_didImpact) continue;
         if (!IsPointInsideDisc2D(Vec2(result.m_impactPosition.x, result.m_impactPosition.y), Vec2(actor->m_position.x, actor->m_position.y), actor->m_radius + 0.1f)) continue;
-        /// End of Line of Sight check
 
-        if (distanceSquared < closestDistanceSquared)
+        return actor;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each local player has one flow field toward its actor, rebuilt only when that actor changes, moves to another tile,
+// or the tile solidity changes.
+void Map::UpdateFlowFields()
+{
+    std::vector<PlayerController*> const& controllers = g_theGame->m_localPlayerControllerList;
+
+    m_flowFieldBuildCount = 0;
+
+    while (m_flowFields.size() < controllers.size())
+    {
+        m_flowFields.emplace_back();
+        m_flowFields.back().Initialize(m_dimensions);
+    }
+
+    for (int controllerIndex = 0; controllerIndex < static_cast<int>(controllers.size()); ++controllerIndex)
+    {
+        FlowField&   flowField   = m_flowFields[controllerIndex];
+        Actor const* playerActor = controllers[controllerIndex]->GetActor();
+
+        if (playerActor == nullptr || playerActor->m_isDead)
+        {
+            flowField.Invalidate();
+            continue;
+        }
+
+        IntVec2 const playerTileCoords = GetTileCoordsFromWorldPos(playerActor->m_position);
+
+        if (flowField.IsValid() &&
+            flowField.m_targetHandle == playerActor->m_handle &&
+            flowField.GetGoalTileCoords() == playerTileCoords &&
+            flowField.GetSolidityVersion() == m_solidityVersion)
         {
-            closestDistanceSquared = distanceSquared;
-            closestEnemy           = actor;
+            continue;
         }
+
+        flowField.m_targetHandle = playerActor->m_handle;
+        flowField.Build(*this, playerTileCoords);
+        m_flowFieldBuildCount++;
     }
+}
 
-    return closestEnemy;
+//----------------------------------------------------------------------------------------------------
+void Map::RespawnPlayers()
+{
+    for (PlayerController* controller : g_theGame->m_localPlayerControllerList)
+    {
+        if (!controller->GetActor())
+        {
+            Actor* playerActor = SpawnPlayer(controller);
+
+            playerActor->SnapPreviousTransform();
+            controller->Possess(playerActor->m_handle);
+            m_actorGrid.Rebuild(m_actors);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns zero when the target has no flow field (it is not a player) or the position has no path,
+// so the caller should steer straight at the target instead.
+Vec2 Map::GetFlowDirectionToward(ActorHandle const& targetHandle,
+                                 Vec3 const&        position) const
+{
+    for (FlowField const& flowField : m_flowFields)
+    {
+        if (flowField.IsValid() && flowField.m_targetHandle == targetHandle)
+        {
+            return flowField.GetDirection(GetTileCoordsFromWorldPos(position));
+        }
+    }
+
+    return Vec2::ZERO;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool Map::FindPath(IntVec2 const&        startTileCoords,
+                   IntVec2 const&        goalTileCoords,
+                   std::vector<IntVec2>& out_waypoints) const
+{
+    return m_pathfinder.FindPath(startTileCoords, goalTileCoords, m_solidityVersion, out_waypoints);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Direction toward the center of the next waypoint on the path from position's tile to goalPosition's tile.
+// Returns zero when both are in the same tile or there is no path.
+Vec2 Map::GetPathDirectionToward(Vec3 const& position,
+                                 Vec3 const& goalPosition) const
+{
+    IntVec2 const startTileCoords = GetTileCoordsFromWorldPos(position);
+    IntVec2 const goalTileCoords  = GetTileCoordsFromWorldPos(goalPosition);
+
+    if (startTileCoords == goalTileCoords) return Vec2::ZERO;
+    if (!FindPath(startTileCoords, goalTileCoords, m_pathWaypoints)) return Vec2::ZERO;
+
+    IntVec2 const nextTileCoords = m_pathWaypoints.front();
+    Vec2 const    nextCenter     = Vec2(static_cast<float>(nextTileCoords.x) + 0.5f, static_cast<float>(nextTileCoords.y) + 0.5f);
+
+    return (nextCenter - Vec2(position.x, position.y)).GetNormalized();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -975,7 +1902,7 @@ void Map::DebugPossessNext() const
 
 	if (playerControlledActor != nullptr)
 	{
-		startIndex = playerControlledActor->m_handle.GetIndex() + 1;
+		startIndex = m_actorSlots[playerControlledActor->m_handle.GetIndex()].m_denseIndex + 1;
 	}
 
 	unsigned int const actorCount = static_cast<unsigned int>(m_actors.size());
@@ -996,3 +1923,31 @@ void Map::DebugPossessNext() const
 		}
 	}
 }
+
+//----------------------------------------------------------------------------------------------------
+// One line per area of the frame, read live while the overlay is on. Byte counts are in KB.
+String Map::GetStatsOverlayText() const
+{
+    String text;
+
+    text += Stringf("Actors: %d actors / %d effects, %d of %d collision pairs overlapped, %d deferred commands\n",
+                    static_cast<int>(m_actors.size()), m_effectSystem->GetEffectCount(),
+                    m_collisionOverlapCount, m_collisionCandidatePairCount, m_deferredCommandCount);
+    text += Stringf("Render: %d draw calls / %u KB uploaded, %d of %d chunks, %d sprites in %d batches\n",
+                    g_renderStats.m_drawCallsLastFrame, static_cast<unsigned int>(g_renderStats.m_bytesUploadedLastFrame / 1024),
+                    static_cast<int>(m_visibleChunkIndices.size()), static_cast<int>(m_chunks.size()),
+                    m_billboardBatcher.GetLastSpriteCount(), m_billboardBatcher.GetLastDrawCallCount());
+    text += Stringf("Update: %s, %d tasks / %d levels, %d jobs in %.3f ms, %d steals on %d threads\n",
+                    m_isUpdateGraphSerial ? "serial" : "parallel", m_updateGraph.GetTaskCount(), m_updateGraph.GetLevelCount(),
+                    m_updateGraph.GetLastJobCount(), m_updateGraph.GetLastExecuteSeconds() * 1000.0,
+                    g_theJobSystem->GetLastStealCount(), g_theJobSystem->GetThreadCount());
+    text += Stringf("AI: %d refreshed / %d queued / %d registered, %d overruns, %d flow fields rebuilt, %d paths cached (%d nodes last search)\n",
+                    m_aiScheduler.GetLastRefreshCount(), m_aiScheduler.GetQueueDepth(), m_aiScheduler.GetRegisteredCount(), m_aiScheduler.GetBudgetOverrunCount(),
+                    m_flowFieldBuildCount, m_pathfinder.GetCacheSize(), m_pathfinder.GetLastExpandedCount());
+    text += Stringf("Memory: PVS %u KB / %d open tiles (%s in %.3f s), bodies %u KB / %d slots, history %u KB / %d frames back to %.2f s",
+                    static_cast<unsigned int>(m_visibilitySet.GetSizeBytes() / 1024), m_visibilitySet.GetOpenTileCount(), m_visibilitySet.WasLoadedFromCache() ? "loaded" : "baked", m_visibilitySet.GetBakeSeconds(),
+                    static_cast<unsigned int>(m_actorBodies.GetSizeBytes() / 1024), m_actorBodies.GetSlotCount(),
+                    static_cast<unsigned int>(m_actorHistory.GetSizeBytes() / 1024), m_actorHistory.GetRecordedFrameCount(), m_actorHistory.GetOldestTimeSeconds());
+
+    return text;
+}
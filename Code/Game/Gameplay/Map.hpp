@@ -4,25 +4,72 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <cstdint>
 
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Framework/AIScheduler.hpp"
+#include "Game/Framework/RandomStream.hpp"
+#include "Game/Framework/TaskGraph.hpp"
+#include "Game/Gameplay/ActorBodySet.hpp"
+#include "Game/Gameplay/ActorCommandBuffer.hpp"
+#include "Game/Gameplay/ActorCylinderSet.hpp"
+#include "Game/Gameplay/ActorHistory.hpp"
+#include "Game/Gameplay/ActorSpatialGrid.hpp"
+#include "Game/Gameplay/BillboardBatcher.hpp"
+#include "Game/Gameplay/FlowField.hpp"
+#include "Game/Gameplay/OccupancyPyramid.hpp"
+#include "Game/Gameplay/TilePathfinder.hpp"
+#include "Game/Gameplay/TileVisibilitySet.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class Actor;
+class EffectSystem;
 class Game;
 class PlayerController;
 class IndexBuffer;
 class Shader;
+class SpriteSheet;
 class Texture;
 struct ActorHandle;
 struct MapDefinition;
 struct SpawnInfo;
-struct Tile;
+struct TileDefinition;
+
+//----------------------------------------------------------------------------------------------------
+// One entry of the map's actor slot map. Slots are recycled through a free list,
+// and the generation is bumped on every destroy so old handles to the slot stop resolving.
+struct ActorSlot
+{
+    Actor*       m_actor      = nullptr;
+    unsigned int m_generation = 0;
+    unsigned int m_denseIndex = 0;      // Index of m_actor in Map::m_actors while the slot is live.
+};
+
+//----------------------------------------------------------------------------------------------------
+// One intersection reported by Map::RaycastPenetrating.
+struct RaycastHit
+{
+    RaycastResult3D m_result;
+    ActorHandle     m_actorHandle;      // INVALID for the wall, floor or ceiling hit that ends the ray.
+};
+
+//----------------------------------------------------------------------------------------------------
+// A block of up to MAP_CHUNK_SIZE x MAP_CHUNK_SIZE tiles with its own GPU buffers, culled per view as a unit.
+struct MapChunk
+{
+    AABB3             m_bounds;
+    VertexList_PCUTBN m_vertexes;                   // Only filled between CreateGeometry and CreateBuffers.
+    IndexList         m_indexes;                    // Only filled between CreateGeometry and CreateBuffers.
+    VertexBuffer*     m_vertexBuffer = nullptr;
+    IndexBuffer*      m_indexBuffer  = nullptr;
+    unsigned int      m_indexCount   = 0;
+};
 
 //----------------------------------------------------------------------------------------------------
 class Map
@@ -33,75 +80,149 @@ public:
 
     void CreateTiles();
     void CreateGeometry();
-    void AddGeometryForWall(VertexList_PCUTBN& verts, IndexList& indexes, AABB3 const& bounds, AABB2 const& UVs) const;
-    void AddGeometryForFloor(VertexList_PCUTBN& verts, IndexList& indexes, AABB3 const& bounds, AABB2 const& UVs) const;
-    void AddGeometryForCeiling(VertexList_PCUTBN& verts, IndexList& indexes, AABB3 const& bounds, AABB2 const& UVs) const;
+    void AddGeometryForWalls(MapChunk& chunk, IntVec2 const& minTileCoords, IntVec2 const& maxTileCoords, SpriteSheet const& spriteSheet) const;
+    void AddGeometryForWallRun(MapChunk& chunk, IntVec2 const& faceDirection, int line, int runStart, int runEnd, AABB2 const& UVs) const;
+    void AddGeometryForFloorsAndCeilings(MapChunk& chunk, IntVec2 const& minTileCoords, IntVec2 const& maxTileCoords, SpriteSheet const& spriteSheet) const;
+    void AddVertsForTiledQuad3D(VertexList_PCUTBN& verts, IndexList& indexes, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topLeft, Vec3 const& topRight, Vec2 const& tileCounts, AABB2 const& cellUVs) const;
     void CreateBuffers();
 
+    uint8_t GetVisibleWallFaceDefinitionIndex(IntVec2 const& tileCoords, IntVec2 const& faceDirection) const;
+    bool    HasWallGeometry(uint8_t defIndex) const;
+    bool    HasFloorGeometry(uint8_t defIndex) const;
+
     bool          IsPositionInBounds(Vec3 const& position, float tolerance = 0.f) const;
     bool          IsTileCoordsOutOfBounds(IntVec2 const& tileCoords) const;
     bool          IsTileCoordsOutOfBounds(int x, int y) const;
     bool          IsTileSolid(IntVec2 const& tileCoords) const;
+    void          SetTileSolid(IntVec2 const& tileCoords, bool isSolid);
+    unsigned int  GetSolidityVersion() const;
     IntVec2 const GetTileCoordsFromWorldPos(Vec3 const& worldPosition) const;
-    Tile const*   GetTile(int x, int y) const;
-    Tile const*   GetTile(IntVec2 const& tileCoords) const;
+    AABB3         GetTileBounds(IntVec2 const& tileCoords) const;
+    uint8_t       GetTileDefinitionIndex(int x, int y) const;
 
+    void CreateUpdateGraph();
     void Update(float deltaSeconds);
     void UpdateFromKeyboard();
-    void UpdateAllActors(float deltaSeconds) const;
+    void SavePreviousActorTransforms(int beginIndex, int endIndex);
+    void ApplyPlayerMoveIntents();
+    void IntegrateActorBodies(float deltaSeconds, int beginSlotIndex, int endSlotIndex);
+    void CopyActorBodyPositions(int beginIndex, int endIndex);
+    int  PrepareActorCommandBuffers();
+    void SteerActors(float deltaSeconds, int chunkIndex, int beginIndex, int endIndex);
+    void UpdateAllActors(float deltaSeconds);
+    void ExecuteActorCommands(ActorCommandBuffer const& commands, float deltaSeconds);
+    void UpdateFlowFields();
+    void RespawnPlayers();
 
     void CollideActors();
-    void CollideActors(Actor* actorA, Actor* actorB);
-    void CollideActorsWithMap() const;
-    void CollideActorWithMap(Actor* actor) const;
+    void CollideActors(int actorIndexA, int actorIndexB);
+    void CollideActorsWithMap(int beginIndex, int endIndex);
+    void CollideActorWithMap(Actor* actor);
 
     void PushActorOutOfTileIfSolid(Actor* actor, IntVec2 const& tileCoords) const;
     void RenderAllActors(PlayerController const* toPlayer) const;
-    void RenderMap() const;
+    void RenderMap(PlayerController const* toPlayer) const;
 
     void Render(PlayerController const* toPlayer) const;
 
     RaycastResult3D RaycastAll(Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
     RaycastResult3D RaycastAll(Actor const* attackerActor, ActorHandle& out_impactedActorHandle, Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
+    RaycastResult3D RaycastAllAtTime(Actor const* attackerActor, ActorHandle& out_impactedActorHandle, Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength, double viewTimeSeconds) const;
+    void            RaycastBatch(Actor const* attackerActor, Vec3 const& startPosition, Vec3 const* forwardNormals, int rayCount, float maxLength, RaycastResult3D* out_results, ActorHandle* out_impactedActorHandles) const;
     RaycastResult3D RaycastWorldXY(Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
     RaycastResult3D RaycastWorldZ(Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
     RaycastResult3D RaycastWorldActors(Actor const* attackerActor, ActorHandle& out_impactedActorHandle, Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
     RaycastResult3D RaycastWorldActors(Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
+    void            RaycastWorldActorsBatch(Actor const* attackerActor, Vec3 const& startPosition, Vec3 const* forwardNormals, int rayCount, float maxLength, RaycastResult3D* out_results, ActorHandle* out_impactedActorHandles) const;
+    int             RaycastPenetrating(Actor const* attackerActor, Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength, RaycastHit* out_hits, int maxHitCount) const;
+    void            SetInterpolationFraction(float fraction);
+    float           GetInterpolationFraction() const;
+    double          GetSimulationSeconds() const;
+    unsigned int    GetTickIndex() const;
+    unsigned int    GetRandomSeed() const;
+    RandomStream&   GetRandomStream();
+    void            UpdateActorCylinder(Actor const& actor);
+    void            UpdateActorBody(Actor const& actor);
+    void            AddActorForce(ActorHandle const& handle, Vec3 const& force);
+    void            AddActorImpulse(ActorHandle const& handle, Vec3 const& impulse);
+    Vec3            GetActorVelocity(ActorHandle const& handle) const;
 
     Actor*       SpawnActor(SpawnInfo const& spawnInfo);
+    bool         SpawnEffect(String const& definitionName, Vec3 const& position) const;
     Actor*       GetActorByHandle(ActorHandle handle) const;
     Actor const* GetActorByName(String const& name) const;
     void         GetActorsByName(std::vector<Actor*>& out_ActorList, String const& name) const;
     void         DeleteDestroyedActor();
     Actor*       SpawnPlayer(PlayerController* playerController);
-    Actor const* GetClosestVisibleEnemy(Actor const* owner) const;
+    Actor const* GetClosestVisibleEnemy(Actor const* owner, PerceptionScratch& scratch) const;
+    Vec2         GetFlowDirectionToward(ActorHandle const& targetHandle, Vec3 const& position) const;
+    bool         FindPath(IntVec2 const& startTileCoords, IntVec2 const& goalTileCoords, std::vector<IntVec2>& out_waypoints) const;
+    Vec2         GetPathDirectionToward(Vec3 const& position, Vec3 const& goalPosition) const;
     void         DebugPossessNext() const;
+    String       GetStatsOverlayText() const;
 
-    Game*               m_game = nullptr;
-    std::vector<Actor*> m_actors;
+    Game*               m_game         = nullptr;
+    EffectSystem*       m_effectSystem = nullptr;
+    std::vector<Actor*> m_actors;       // Dense list of live actors, in spawn order. Never contains nullptr.
 
     Vec3  m_sunDirection     = Vec3(2.f, 1.f, -1.f).GetNormalized();
     float m_sunIntensity     = 0.85f;
     float m_ambientIntensity = 0.35f;
 
+    bool m_isStatsOverlayVisible = false;   // Per-system counters drawn by Game beside the frame stats (I).
+
 protected:
     // Map
-    MapDefinition const* m_mapDefinition = nullptr;
-    std::vector<Tile>    m_tiles;
-    IntVec2              m_dimensions;
+    MapDefinition const*  m_mapDefinition = nullptr;
+    std::vector<uint8_t>  m_tileDefinitionIndices;          // Index into TileDefinition::s_tileDefinitions per tile, indexed by x + y * m_dimensions.x.
+    std::vector<uint64_t> m_solidTileBits;                  // One bit per tile, same indexing as m_tileDefinitionIndices.
+    uint8_t               m_wallDefinitionIndex  = 0xffu;   // Tile definition that gets wall geometry.
+    uint8_t               m_floorDefinitionIndex = 0xffu;   // Tile definition that gets floor and ceiling geometry.
+    unsigned int          m_solidityVersion      = 0;       // Bumped whenever m_solidTileBits changes, so paths and flow fields can tell they are stale.
+    IntVec2               m_dimensions;
+    OccupancyPyramid      m_occupancyPyramid;               // Empty-block skipping for RaycastWorldXY, kept in sync by SetTileSolid.
+    TileVisibilitySet     m_visibilitySet;                  // Tile-to-tile PVS baked from m_solidTileBits, rejects perception rays early.
 
     // Rendering
-    VertexList_PCUTBN m_vertexes;
-    IndexList         m_indexes;
-    Texture const*    m_texture      = nullptr;
-    Shader*           m_shader       = nullptr;
-    VertexBuffer*     m_vertexBuffer = nullptr;
-    IndexBuffer*      m_indexBuffer  = nullptr;
-
+    static constexpr int     MAP_CHUNK_SIZE = 16;
+    std::vector<MapChunk>    m_chunks;                  // Indexed by chunkX + chunkY * m_chunkCounts.x.
+    IntVec2                  m_chunkCounts;
+    mutable std::vector<int> m_visibleChunkIndices;     // Chunks that survived culling in the last view, nearest first.
+    Texture const*           m_texture = nullptr;
+    Shader*                  m_shader  = nullptr;
 
+    mutable BillboardBatcher m_billboardBatcher;    // Actor and effect sprites, rebuilt for every view.
 
     // Actor
-    static constexpr unsigned int MAX_ACTOR_UID      = 0x0000fffeu;
-    unsigned int                  m_nextActorUID     = 0;
-    PlayerController*             m_playerController = nullptr;
+    ActorSpatialGrid                m_actorGrid;                       // Broadphase, rebuilt before and after actors move each frame.
+    ActorBodySet                    m_actorBodies;                     // SoA physics state (position, velocity, forces, radius, height), indexed by slot.
+    ActorCylinderSet                m_actorCylinders;                  // SoA copy of actor cylinders for raycasts, indexed like m_actors.
+    ActorHistory                    m_actorHistory;                    // Recent actor cylinders per tick, for rewound hitscans.
+    std::vector<unsigned int>       m_collisionQueryResults;           // Scratch list reused by CollideActors.
+    int                             m_collisionCandidatePairCount = 0; // Pairs that reached the narrow phase last frame.
+    int                             m_collisionOverlapCount       = 0; // Pairs that actually overlapped last frame.
+    static constexpr unsigned int   MAX_ACTOR_SLOT_COUNT = 0x0000fffeu;
+    std::vector<ActorSlot>          m_actorSlots;                      // Indexed by ActorHandle::GetIndex().
+    std::vector<unsigned int>       m_freeActorSlotIndices;            // Slots whose actor was destroyed, reused before growing m_actorSlots.
+    std::vector<unsigned int>       m_actorSlotIndices;                // Slot index of each entry of m_actors, so dense loops reach m_actorBodies directly.
+    static constexpr int            ACTOR_CHUNK_SIZE = 256;            // Actors (or body slots) per job in the parallel update phase; a multiple of ActorBodySet::LANE_COUNT.
+    std::vector<ActorCommandBuffer> m_actorCommandBuffers;             // One per chunk of the parallel update phase, executed in chunk order.
+    int                             m_actorCommandBufferCount = 0;     // Buffers filled by this frame's steering, the rest are stale.
+    int                             m_deferredCommandCount    = 0;     // Commands recorded by the parallel phase last frame.
+    PlayerController*               m_playerController = nullptr;
+    AIScheduler                     m_aiScheduler;                     // Staggers AI target refreshes across frames.
+    std::vector<FlowField>          m_flowFields;                      // One per local player, leading to that player's actor.
+    int                             m_flowFieldBuildCount = 0;         // Flow field rebuilds last frame.
+    mutable TilePathfinder          m_pathfinder;                      // Point-to-point routes over m_solidTileBits, cached per (start, goal).
+    mutable std::vector<IntVec2>    m_pathWaypoints;                   // Scratch path reused by GetPathDirectionToward.
+
+    // Update
+    TaskGraph    m_updateGraph;                     // Phases of Update and their data dependencies, built once by CreateUpdateGraph.
+    float        m_updateDeltaSeconds    = 0.f;     // Delta of the Update in progress, read by the graph's tasks.
+    bool         m_isUpdateGraphSerial   = false;   // Runs the graph's tasks one after another on the main thread, for comparison (F10).
+    double       m_simulationSeconds     = 0.0;     // Sum of every Update's delta; the time base of m_actorHistory.
+    float        m_interpolationFraction = 1.f;     // How far rendering is between each actor's previous and current transform.
+    unsigned int m_tickIndex             = 0;       // Updates run so far; keys every RandomStream of the map along with the seed.
+    unsigned int m_randomSeed            = 0;       // From Simulation.RandomSeed.
+    RandomStream m_randomStream;                    // Map-level draws (spawn points), re-keyed every tick by GetRandomStream.
 };
@@ -0,0 +1,313 @@
+//----------------------------------------------------------------------------------------------------
+// OccupancyPyramid.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/OccupancyPyramid.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Gameplay/TileRayWalker.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void OccupancyPyramid::Initialize(IntVec2 const&               dimensions,
+                                  std::vector<uint64_t> const* solidTileBits)
+{
+    m_dimensions    = dimensions;
+    m_solidTileBits = solidTileBits;
+
+    m_levelDimensions.clear();
+    m_levelBits.clear();
+    m_levelDimensions.push_back(dimensions);
+    m_levelBits.emplace_back();
+
+    // Halve (rounding up) until a single cell covers the whole map, then fill each level from the one below.
+    while (m_levelDimensions.back().x > 1 || m_levelDimensions.back().y > 1)
+    {
+        IntVec2 const childDimensions = m_levelDimensions.back();
+        IntVec2 const levelDimensions = IntVec2((childDimensions.x + 1) / 2, (childDimensions.y + 1) / 2);
+        int const     level           = static_cast<int>(m_levelDimensions.size());
+
+        m_levelDimensions.push_back(levelDimensions);
+        m_levelBits.emplace_back((static_cast<size_t>(levelDimensions.x) * levelDimensions.y + 63) / 64, 0);
+
+        for (int cellY = 0; cellY < levelDimensions.y; ++cellY)
+        {
+            for (int cellX = 0; cellX < levelDimensions.x; ++cellX)
+            {
+                UpdateCell(level, cellX, cellY);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Call after the tile's bit in the solidity bitset changed; refreshes its ancestor in every level, O(level count).
+void OccupancyPyramid::OnTileChanged(IntVec2 const& tileCoords)
+{
+    for (int level = 1; level < static_cast<int>(m_levelBits.size()); ++level)
+    {
+        UpdateCell(level, tileCoords.x >> level, tileCoords.y >> level);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same contract as Map::RaycastWorldXY: the first solid tile the ray enters whose entry point lies within the wall height.
+RaycastResult3D OccupancyPyramid::RaycastXY(Vec3 const& startPosition,
+                                            Vec3 const& forwardNormal,
+                                            float const maxLength,
+                                            bool const  skipEmptyBlocks) const
+{
+    // 1. Initialize raycastResult3D.
+    RaycastResult3D result;
+    result.m_rayStartPosition = startPosition;
+    result.m_rayForwardNormal = forwardNormal;
+    result.m_rayMaxLength     = maxLength;
+    result.m_didImpact        = false;
+    result.m_impactPosition   = startPosition;
+    result.m_impactNormal     = -forwardNormal;
+    result.m_impactLength     = 0.f;
+
+    m_lastStepCount = 0;
+
+    // 2. If the ray has no XY component, it can never cross a tile edge, so it would never impact a wall.
+    TileRayWalker walker(startPosition, forwardNormal);
+
+    if (!walker.IsMoving()) return result;
+
+    int const        topLevel    = static_cast<int>(m_levelBits.size()) - 1;
+    FloatRange const rangeWorldZ = FloatRange(0.f, 1.f);
+
+    while (true)
+    {
+        IntVec2 const tileCoords = walker.GetTileCoords();
+        bool const    isInside   = tileCoords.x >= 0 && tileCoords.y >= 0 && tileCoords.x < m_dimensions.x && tileCoords.y < m_dimensions.y;
+
+        m_lastStepCount++;
+
+        // 3. Find the largest empty block around the current tile. Ancestors of an occupied cell are occupied,
+        // so the search stops at the first occupied level.
+        int emptyLevel = 0;
+
+        if (skipEmptyBlocks && isInside)
+        {
+            while (emptyLevel < topLevel && !IsCellOccupied(emptyLevel + 1, tileCoords.x >> (emptyLevel + 1), tileCoords.y >> (emptyLevel + 1)))
+            {
+                emptyLevel++;
+            }
+        }
+
+        // 4. Leave the block in one step, or step into the next tile through whichever edge is closer.
+        if (emptyLevel >= MIN_SKIP_LEVEL)
+        {
+            walker.SkipBlock(IntVec2(tileCoords.x >> emptyLevel << emptyLevel, tileCoords.y >> emptyLevel << emptyLevel), 1 << emptyLevel);
+        }
+        else
+        {
+            walker.Step();
+        }
+
+        float const currentLength = walker.GetEntryLength();
+
+        if (currentLength > maxLength) { break; }
+
+        // 5. If the current tile is not in the map or not solid, keep walking.
+        if (!IsTileSolid(walker.GetTileCoords().x, walker.GetTileCoords().y)) { continue; }
+
+        // 6. The entry point is exact, so only the Z range of the wall needs to be checked.
+        Vec3 const impactPosition = startPosition + forwardNormal * currentLength;
+
+        if (rangeWorldZ.IsOnRange(impactPosition.z))
+        {
+            IntVec2 const impactNormal = walker.GetEntryNormal();
+
+            result.m_didImpact      = true;
+            result.m_impactPosition = impactPosition;
+            result.m_impactNormal   = Vec3(static_cast<float>(impactNormal.x), static_cast<float>(impactNormal.y), 0.f);
+            result.m_impactLength   = currentLength;
+
+            return result;
+        }
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+int OccupancyPyramid::GetLevelCount() const
+{
+    return static_cast<int>(m_levelDimensions.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int OccupancyPyramid::GetLastStepCount() const
+{
+    return m_lastStepCount;
+}
+
+#if defined(GAME_BENCHMARKS)
+//----------------------------------------------------------------------------------------------------
+// Long random rays over generated 1024x1024 maps with sparse pillars and a few long walls, walked tile by tile and with
+// empty-block skipping. Both walks must agree on every ray; the report gives rays per second and steps per ray for each.
+STATIC void OccupancyPyramid::RunBenchmark()
+{
+    IntVec2 const mapSize         = IntVec2(1024, 1024);
+    float const   pillarChances[] = { 0.001f, 0.01f };
+    int const     rayCount        = 2000;
+    float const   maxLength       = 1500.f;
+
+    for (float const pillarChance : pillarChances)
+    {
+        // 1. Generate the solidity bitset: a solid border, scattered pillars, and long wall segments.
+        std::vector<uint64_t> solidTileBits((static_cast<size_t>(mapSize.x) * mapSize.y + 63) / 64, 0);
+
+        auto const setSolid = [&solidTileBits, &mapSize](int x, int y)
+        {
+            int const tileIndex = x + y * mapSize.x;
+            solidTileBits[tileIndex >> 6] |= 1ull << (tileIndex & 63);
+        };
+
+        for (int y = 0; y < mapSize.y; ++y)
+        {
+            for (int x = 0; x < mapSize.x; ++x)
+            {
+                bool const isBorder = x == 0 || y == 0 || x == mapSize.x - 1 || y == mapSize.y - 1;
+
+                if (isBorder || g_theRNG->RollRandomFloatInRange(0.f, 1.f) < pillarChance) setSolid(x, y);
+            }
+        }
+
+        for (int wallIndex = 0; wallIndex < 32; ++wallIndex)
+        {
+            int const  x            = g_theRNG->RollRandomIntInRange(1, mapSize.x - 2);
+            int const  y            = g_theRNG->RollRandomIntInRange(1, mapSize.y - 2);
+            int const  length       = g_theRNG->RollRandomIntInRange(16, 256);
+            bool const isHorizontal = g_theRNG->RollRandomIntInRange(0, 1) == 0;
+
+            for (int step = 0; step < length; ++step)
+            {
+                int const tileX = isHorizontal ? x + step : x;
+                int const tileY = isHorizontal ? y : y + step;
+
+                if (tileX < mapSize.x - 1 && tileY < mapSize.y - 1) setSolid(tileX, tileY);
+            }
+        }
+
+        OccupancyPyramid pyramid;
+        pyramid.Initialize(mapSize, &solidTileBits);
+
+        // 2. Random rays from open tiles, at eye height.
+        std::vector<Vec3> rayStarts;
+        std::vector<Vec3> rayForwards;
+        rayStarts.reserve(rayCount);
+        rayForwards.reserve(rayCount);
+
+        while (static_cast<int>(rayStarts.size()) < rayCount)
+        {
+            Vec3 const start = Vec3(g_theRNG->RollRandomFloatInRange(1.f, static_cast<float>(mapSize.x - 1)),
+                                    g_theRNG->RollRandomFloatInRange(1.f, static_cast<float>(mapSize.y - 1)),
+                                    0.5f);
+
+            if (pyramid.IsTileSolid(RoundDownToInt(start.x), RoundDownToInt(start.y))) continue;
+
+            float const degrees = g_theRNG->RollRandomFloatInRange(0.f, 360.f);
+
+            rayStarts.push_back(start);
+            rayForwards.push_back(Vec3(CosDegrees(degrees), SinDegrees(degrees), 0.f));
+        }
+
+        // 3. Time both walks and compare every result.
+        std::vector<RaycastResult3D> flatResults(rayCount);
+        int                          flatStepCount = 0;
+        double const                 flatStart     = GetCurrentTimeSeconds();
+
+        for (int rayIndex = 0; rayIndex < rayCount; ++rayIndex)
+        {
+            flatResults[rayIndex] = pyramid.RaycastXY(rayStarts[rayIndex], rayForwards[rayIndex], maxLength, false);
+            flatStepCount += pyramid.GetLastStepCount();
+        }
+
+        int          skipStepCount = 0;
+        int          mismatchCount = 0;
+        double const skipStart     = GetCurrentTimeSeconds();
+
+        for (int rayIndex = 0; rayIndex < rayCount; ++rayIndex)
+        {
+            RaycastResult3D const result = pyramid.RaycastXY(rayStarts[rayIndex], rayForwards[rayIndex], maxLength, true);
+            skipStepCount += pyramid.GetLastStepCount();
+
+            if (result.m_didImpact != flatResults[rayIndex].m_didImpact ||
+                result.m_impactLength != flatResults[rayIndex].m_impactLength)
+            {
+                mismatchCount++;
+            }
+        }
+
+        double const skipEnd     = GetCurrentTimeSeconds();
+        double const flatSeconds = skipStart - flatStart > 0.0 ? skipStart - flatStart : 1e-9;
+        double const skipSeconds = skipEnd - skipStart > 0.0 ? skipEnd - skipStart : 1e-9;
+        String const report      = Stringf("Raycast %dx%d, %.1f%% pillars: flat %.0f rays/s (%d steps avg), pyramid %.0f rays/s (%d steps avg), %d mismatches",
+                                           mapSize.x, mapSize.y, pillarChance * 100.f,
+                                           static_cast<double>(rayCount) / flatSeconds, flatStepCount / rayCount,
+                                           static_cast<double>(rayCount) / skipSeconds, skipStepCount / rayCount,
+                                           mismatchCount);
+
+        DebuggerPrintf("%s\n", report.c_str());
+        DebugAddMessage(report, 10.f);
+    }
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------
+bool OccupancyPyramid::IsTileSolid(int const x,
+                                   int const y) const
+{
+    if (x < 0 || y < 0 || x >= m_dimensions.x || y >= m_dimensions.y) return false;
+
+    int const tileIndex = x + y * m_dimensions.x;
+
+    return ((*m_solidTileBits)[tileIndex >> 6] >> (tileIndex & 63) & 1ull) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool OccupancyPyramid::IsCellOccupied(int const level,
+                                      int const cellX,
+                                      int const cellY) const
+{
+    if (level == 0) return IsTileSolid(cellX, cellY);
+
+    IntVec2 const levelDimensions = m_levelDimensions[level];
+    int const     cellIndex       = cellX + cellY * levelDimensions.x;
+
+    return (m_levelBits[level][cellIndex >> 6] >> (cellIndex & 63) & 1ull) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ORs the (up to) 2x2 children; children past the edge of the level below count as empty.
+void OccupancyPyramid::UpdateCell(int const level,
+                                  int const cellX,
+                                  int const cellY)
+{
+    IntVec2 const childDimensions = m_levelDimensions[level - 1];
+    bool          isOccupied      = false;
+
+    for (int childY = cellY * 2; childY < cellY * 2 + 2 && childY < childDimensions.y && !isOccupied; ++childY)
+    {
+        for (int childX = cellX * 2; childX < cellX * 2 + 2 && childX < childDimensions.x && !isOccupied; ++childX)
+        {
+            isOccupied = IsCellOccupied(level - 1, childX, childY);
+        }
+    }
+
+    int const      cellIndex = cellX + cellY * m_levelDimensions[level].x;
+    uint64_t const cellBit   = 1ull << (cellIndex & 63);
+    uint64_t&      word      = m_levelBits[level][cellIndex >> 6];
+
+    word = isOccupied ? word | cellBit : word & ~cellBit;
+}
@@ -0,0 +1,45 @@
+//----------------------------------------------------------------------------------------------------
+// OccupancyPyramid.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Mip pyramid over a tile solidity bitset: level 0 is the bitset itself, and each cell of level L is set if any of its 2x2
+// children in level L - 1 is, so a clear level L cell proves a (2^L x 2^L) block of tiles empty.
+// RaycastXY is the wall traversal of Map::RaycastWorldXY; it skips a whole empty block in one TileRayWalker::SkipBlock,
+// which lands on the tile a tile-by-tile walk would reach at the same length, so both modes find the same wall bit for bit.
+class OccupancyPyramid
+{
+public:
+    void Initialize(IntVec2 const& dimensions, std::vector<uint64_t> const* solidTileBits);
+    void OnTileChanged(IntVec2 const& tileCoords);
+
+    RaycastResult3D RaycastXY(Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength, bool skipEmptyBlocks = true) const;
+
+    int GetLevelCount() const;
+    int GetLastStepCount() const;
+
+#if defined(GAME_BENCHMARKS)
+    static void RunBenchmark();
+#endif
+
+    static constexpr int MIN_SKIP_LEVEL = 2;   // Skipping a 2x2 block saves less than the skip costs, so blocks start at 4x4.
+
+private:
+    bool IsTileSolid(int x, int y) const;
+    bool IsCellOccupied(int level, int cellX, int cellY) const;
+    void UpdateCell(int level, int cellX, int cellY);
+
+    IntVec2                            m_dimensions    = IntVec2::ZERO;
+    std::vector<uint64_t> const*       m_solidTileBits = nullptr;   // Level 0, indexed by x + y * m_dimensions.x. Not owned.
+    std::vector<IntVec2>               m_levelDimensions;           // Cell counts per level; entry 0 is m_dimensions.
+    std::vector<std::vector<uint64_t>> m_levelBits;                 // One bit per cell for levels 1 and up; entry 0 is unused.
+    mutable int                        m_lastStepCount = 0;         // Tile steps plus block skips taken by the last RaycastXY.
+};
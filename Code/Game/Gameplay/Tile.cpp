@@ -1,6 +0,0 @@
-//----------------------------------------------------------------------------------------------------
-// Tile.cpp
-//----------------------------------------------------------------------------------------------------
-
-//----------------------------------------------------------------------------------------------------
-#include "Game/Gameplay/Tile.hpp"
\ No newline at end of file
@@ -0,0 +1,423 @@
+//----------------------------------------------------------------------------------------------------
+// TilePathfinder.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/TilePathfinder.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#include "Game/Framework/GameCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void TilePathfinder::Initialize(IntVec2 const&               dimensions,
+                                std::vector<uint64_t> const* solidTileBits)
+{
+    m_dimensions    = dimensions;
+    m_solidTileBits = solidTileBits;
+    m_nodes.assign(static_cast<size_t>(dimensions.x) * dimensions.y, SearchNode());
+    m_openHeap.reserve(m_nodes.size());
+    m_searchStamp = 0;
+    ClearCache();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Cached query. The whole cache is dropped when the solidity version differs from the one it was filled under.
+bool TilePathfinder::FindPath(IntVec2 const&        startTileCoords,
+                              IntVec2 const&        goalTileCoords,
+                              unsigned int const    solidityVersion,
+                              std::vector<IntVec2>& out_waypoints)
+{
+    out_waypoints.clear();
+
+    if (!IsWalkable(startTileCoords.x, startTileCoords.y) || !IsWalkable(goalTileCoords.x, goalTileCoords.y)) return false;
+
+    if (solidityVersion != m_cacheSolidityVersion)
+    {
+        ClearCache();
+        m_cacheSolidityVersion = solidityVersion;
+    }
+
+    uint64_t const startIndex = static_cast<uint64_t>(startTileCoords.x + startTileCoords.y * m_dimensions.x);
+    uint64_t const goalIndex  = static_cast<uint64_t>(goalTileCoords.x + goalTileCoords.y * m_dimensions.x);
+    uint64_t const key        = startIndex << 32 | goalIndex;
+
+    auto const found = m_pathCache.find(key);
+
+    if (found != m_pathCache.end())
+    {
+        out_waypoints = found->second;
+        return !out_waypoints.empty();
+    }
+
+    if (static_cast<int>(m_pathCache.size()) >= MAX_CACHED_PATH_COUNT)
+    {
+        m_pathCache.clear();
+    }
+
+    bool const isFound = FindPathUncached(startTileCoords, goalTileCoords, out_waypoints);
+
+    m_pathCache[key] = out_waypoints;
+
+    return isFound;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Fills out_waypoints with the jump points from the start (excluded) to the goal (included).
+// Consecutive waypoints are joined by an unobstructed straight or diagonal line.
+bool TilePathfinder::FindPathUncached(IntVec2 const&        startTileCoords,
+                                      IntVec2 const&        goalTileCoords,
+                                      std::vector<IntVec2>& out_waypoints)
+{
+    out_waypoints.clear();
+    m_lastExpandedCount = 0;
+
+    if (!IsWalkable(startTileCoords.x, startTileCoords.y) || !IsWalkable(goalTileCoords.x, goalTileCoords.y)) return false;
+
+    if (startTileCoords == goalTileCoords)
+    {
+        out_waypoints.push_back(goalTileCoords);
+        return true;
+    }
+
+    // 1. Start a new search. Bumping the stamp resets every node at once; only a wrap needs a real reset.
+    m_searchStamp++;
+
+    if (m_searchStamp == 0)
+    {
+        for (SearchNode& node : m_nodes)
+        {
+            node.m_openStamp   = 0;
+            node.m_closedStamp = 0;
+        }
+
+        m_searchStamp = 1;
+    }
+
+    m_openHeap.clear();
+
+    int const   startIndex = startTileCoords.x + startTileCoords.y * m_dimensions.x;
+    int const   goalIndex  = goalTileCoords.x + goalTileCoords.y * m_dimensions.x;
+    SearchNode& startNode  = m_nodes[startIndex];
+
+    startNode.m_gScore      = 0.f;
+    startNode.m_parentIndex = -1;
+    startNode.m_openStamp   = m_searchStamp;
+    PushOpen(startIndex, GetOctileDistance(goalTileCoords.x - startTileCoords.x, goalTileCoords.y - startTileCoords.y));
+
+    auto const isWorseOnTop = [](OpenEntry const& a, OpenEntry const& b) { return a.m_fScore > b.m_fScore; };
+
+    // 2. Expand jump points in f-score order.
+    while (!m_openHeap.empty())
+    {
+        std::pop_heap(m_openHeap.begin(), m_openHeap.end(), isWorseOnTop);
+        int const tileIndex = m_openHeap.back().m_tileIndex;
+        m_openHeap.pop_back();
+
+        SearchNode& node = m_nodes[tileIndex];
+
+        if (node.m_closedStamp == m_searchStamp) continue;
+
+        node.m_closedStamp = m_searchStamp;
+        m_lastExpandedCount++;
+
+        if (tileIndex == goalIndex)
+        {
+            // 3. Walk the parents back to the start.
+            for (int pathIndex = goalIndex; pathIndex != startIndex; pathIndex = m_nodes[pathIndex].m_parentIndex)
+            {
+                out_waypoints.push_back(IntVec2(pathIndex % m_dimensions.x, pathIndex / m_dimensions.x));
+            }
+
+            std::reverse(out_waypoints.begin(), out_waypoints.end());
+            return true;
+        }
+
+        int const x = tileIndex % m_dimensions.x;
+        int const y = tileIndex / m_dimensions.x;
+
+        if (node.m_parentIndex < 0)
+        {
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    if (dx != 0 || dy != 0) AddJumpSuccessor(tileIndex, dx, dy, goalTileCoords);
+                }
+            }
+
+            continue;
+        }
+
+        // Prune to the natural and forced directions for the way we arrived.
+        int const parentX = node.m_parentIndex % m_dimensions.x;
+        int const parentY = node.m_parentIndex / m_dimensions.x;
+        int const dx      = x > parentX ? 1 : (x < parentX ? -1 : 0);
+        int const dy      = y > parentY ? 1 : (y < parentY ? -1 : 0);
+
+        if (dx != 0 && dy != 0)
+        {
+            AddJumpSuccessor(tileIndex, dx, 0, goalTileCoords);
+            AddJumpSuccessor(tileIndex, 0, dy, goalTileCoords);
+            AddJumpSuccessor(tileIndex, dx, dy, goalTileCoords);
+        }
+        else if (dx != 0)
+        {
+            AddJumpSuccessor(tileIndex, dx, 0, goalTileCoords);
+            AddJumpSuccessor(tileIndex, 0, 1, goalTileCoords);
+            AddJumpSuccessor(tileIndex, 0, -1, goalTileCoords);
+            AddJumpSuccessor(tileIndex, dx, 1, goalTileCoords);
+            AddJumpSuccessor(tileIndex, dx, -1, goalTileCoords);
+        }
+        else
+        {
+            AddJumpSuccessor(tileIndex, 0, dy, goalTileCoords);
+            AddJumpSuccessor(tileIndex, 1, 0, goalTileCoords);
+            AddJumpSuccessor(tileIndex, -1, 0, goalTileCoords);
+            AddJumpSuccessor(tileIndex, 1, dy, goalTileCoords);
+            AddJumpSuccessor(tileIndex, -1, dy, goalTileCoords);
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TilePathfinder::ClearCache()
+{
+    m_pathCache.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+int TilePathfinder::GetCacheSize() const
+{
+    return static_cast<int>(m_pathCache.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int TilePathfinder::GetLastExpandedCount() const
+{
+    return m_lastExpandedCount;
+}
+
+#if defined(GAME_BENCHMARKS)
+//----------------------------------------------------------------------------------------------------
+// Generated maps: solid border, 25% random interior walls. Reports uncached and cached queries per second.
+STATIC void TilePathfinder::RunBenchmark()
+{
+    IntVec2 const mapSizes[2] = { IntVec2(64, 64), IntVec2(512, 512) };
+    int const     queryCount  = 500;
+
+    for (IntVec2 const& mapSize : mapSizes)
+    {
+        // 1. Generate the solidity bitset.
+        std::vector<uint64_t> solidTileBits((static_cast<size_t>(mapSize.x) * mapSize.y + 63) / 64, 0);
+
+        for (int y = 0; y < mapSize.y; ++y)
+        {
+            for (int x = 0; x < mapSize.x; ++x)
+            {
+                bool const isBorder = x == 0 || y == 0 || x == mapSize.x - 1 || y == mapSize.y - 1;
+
+                if (isBorder || g_theRNG->RollRandomFloatInRange(0.f, 1.f) < 0.25f)
+                {
+                    int const tileIndex = x + y * mapSize.x;
+                    solidTileBits[tileIndex >> 6] |= 1ull << (tileIndex & 63);
+                }
+            }
+        }
+
+        TilePathfinder pathfinder;
+        pathfinder.Initialize(mapSize, &solidTileBits);
+
+        // 2. Pick random open start and goal tiles.
+        std::vector<IntVec2> queryTileCoords;
+        queryTileCoords.reserve(queryCount * 2);
+
+        while (static_cast<int>(queryTileCoords.size()) < queryCount * 2)
+        {
+            IntVec2 const tileCoords = IntVec2(g_theRNG->RollRandomIntInRange(1, mapSize.x - 2), g_theRNG->RollRandomIntInRange(1, mapSize.y - 2));
+
+            if (pathfinder.IsWalkable(tileCoords.x, tileCoords.y)) queryTileCoords.push_back(tileCoords);
+        }
+
+        // 3. Time the searches, then the same queries again from the cache.
+        std::vector<IntVec2> waypoints;
+        int                  foundCount    = 0;
+        int                  expandedCount = 0;
+        double const         searchStart   = GetCurrentTimeSeconds();
+
+        for (int queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+        {
+            if (pathfinder.FindPath(queryTileCoords[queryIndex * 2], queryTileCoords[queryIndex * 2 + 1], 1, waypoints)) foundCount++;
+            expandedCount += pathfinder.GetLastExpandedCount();
+        }
+
+        double const cacheStart = GetCurrentTimeSeconds();
+
+        for (int queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+        {
+            pathfinder.FindPath(queryTileCoords[queryIndex * 2], queryTileCoords[queryIndex * 2 + 1], 1, waypoints);
+        }
+
+        double const cacheEnd      = GetCurrentTimeSeconds();
+        double const searchSeconds = cacheStart - searchStart > 0.0 ? cacheStart - searchStart : 1e-9;
+        double const cachedSeconds = cacheEnd - cacheStart > 0.0 ? cacheEnd - cacheStart : 1e-9;
+        String const report        = Stringf("Pathfinding %dx%d: %.0f queries/s searched (%d/%d found, %d nodes expanded avg), %.0f queries/s cached",
+                                             mapSize.x, mapSize.y,
+                                             static_cast<double>(queryCount) / searchSeconds, foundCount, queryCount, expandedCount / queryCount,
+                                             static_cast<double>(queryCount) / cachedSeconds);
+
+        DebuggerPrintf("%s\n", report.c_str());
+        DebugAddMessage(report, 10.f);
+    }
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------
+// Octile distance: the exact path length between two tiles on an open 8-way grid.
+STATIC float TilePathfinder::GetOctileDistance(int const deltaX,
+                                             int const deltaY)
+{
+    int const absX = deltaX < 0 ? -deltaX : deltaX;
+    int const absY = deltaY < 0 ? -deltaY : deltaY;
+    int const minD = absX < absY ? absX : absY;
+    int const maxD = absX < absY ? absY : absX;
+
+    return static_cast<float>(maxD - minD) + 1.41421356f * static_cast<float>(minD);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Tiles outside the map are treated as solid.
+bool TilePathfinder::IsWalkable(int const x,
+                                int const y) const
+{
+    if (x < 0 || y < 0 || x >= m_dimensions.x || y >= m_dimensions.y) return false;
+
+    int const tileIndex = x + y * m_dimensions.x;
+
+    return ((*m_solidTileBits)[tileIndex >> 6] >> (tileIndex & 63) & 1ull) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A diagonal step needs the destination and both tiles beside it open.
+bool TilePathfinder::IsWalkableDiagonalStep(int const x,
+                                            int const y,
+                                            int const dx,
+                                            int const dy) const
+{
+    return IsWalkable(x + dx, y) && IsWalkable(x, y + dy) && IsWalkable(x + dx, y + dy);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walk from (x, y) along a straight direction until the goal, a tile with a forced neighbour, or a wall.
+// With no corner cutting, a neighbour is forced where the wall beside the previous tile ends.
+bool TilePathfinder::JumpStraight(int            x,
+                                  int            y,
+                                  int const      dx,
+                                  int const      dy,
+                                  IntVec2 const& goalTileCoords,
+                                  IntVec2&       out_jumpPoint) const
+{
+    while (true)
+    {
+        x += dx;
+        y += dy;
+
+        if (!IsWalkable(x, y)) return false;
+
+        bool isJumpPoint = x == goalTileCoords.x && y == goalTileCoords.y;
+
+        if (dx != 0)
+        {
+            isJumpPoint = isJumpPoint ||
+                (IsWalkable(x, y - 1) && !IsWalkable(x - dx, y - 1)) ||
+                (IsWalkable(x, y + 1) && !IsWalkable(x - dx, y + 1));
+        }
+        else
+        {
+            isJumpPoint = isJumpPoint ||
+                (IsWalkable(x - 1, y) && !IsWalkable(x - 1, y - dy)) ||
+                (IsWalkable(x + 1, y) && !IsWalkable(x + 1, y - dy));
+        }
+
+        if (isJumpPoint)
+        {
+            out_jumpPoint = IntVec2(x, y);
+            return true;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walk diagonally; a tile is a jump point if the goal is there or either straight component finds one.
+bool TilePathfinder::JumpDiagonal(int            x,
+                                  int            y,
+                                  int const      dx,
+                                  int const      dy,
+                                  IntVec2 const& goalTileCoords,
+                                  IntVec2&       out_jumpPoint) const
+{
+    IntVec2 straightJumpPoint;
+
+    while (true)
+    {
+        if (!IsWalkableDiagonalStep(x, y, dx, dy)) return false;
+
+        x += dx;
+        y += dy;
+
+        if ((x == goalTileCoords.x && y == goalTileCoords.y) ||
+            JumpStraight(x, y, dx, 0, goalTileCoords, straightJumpPoint) ||
+            JumpStraight(x, y, 0, dy, goalTileCoords, straightJumpPoint))
+        {
+            out_jumpPoint = IntVec2(x, y);
+            return true;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void TilePathfinder::AddJumpSuccessor(int const      parentIndex,
+                                      int const      dx,
+                                      int const      dy,
+                                      IntVec2 const& goalTileCoords)
+{
+    int const parentX = parentIndex % m_dimensions.x;
+    int const parentY = parentIndex / m_dimensions.x;
+
+    IntVec2    jumpPoint;
+    bool const isFound = dx != 0 && dy != 0
+                             ? JumpDiagonal(parentX, parentY, dx, dy, goalTileCoords, jumpPoint)
+                             : JumpStraight(parentX, parentY, dx, dy, goalTileCoords, jumpPoint);
+
+    if (!isFound) return;
+
+    int const   jumpIndex = jumpPoint.x + jumpPoint.y * m_dimensions.x;
+    SearchNode& jumpNode  = m_nodes[jumpIndex];
+
+    if (jumpNode.m_closedStamp == m_searchStamp) return;
+
+    float const gScore = m_nodes[parentIndex].m_gScore + GetOctileDistance(jumpPoint.x - parentX, jumpPoint.y - parentY);
+
+    if (jumpNode.m_openStamp == m_searchStamp && gScore >= jumpNode.m_gScore) return;
+
+    jumpNode.m_gScore      = gScore;
+    jumpNode.m_parentIndex = parentIndex;
+    jumpNode.m_openStamp   = m_searchStamp;
+    PushOpen(jumpIndex, gScore + GetOctileDistance(goalTileCoords.x - jumpPoint.x, goalTileCoords.y - jumpPoint.y));
+}
+
+//----------------------------------------------------------------------------------------------------
+void TilePathfinder::PushOpen(int const   tileIndex,
+                              float const fScore)
+{
+    m_openHeap.push_back(OpenEntry{ fScore, tileIndex });
+    std::push_heap(m_openHeap.begin(), m_openHeap.end(), [](OpenEntry const& a, OpenEntry const& b) { return a.m_fScore > b.m_fScore; });
+}
@@ -0,0 +1,69 @@
+//----------------------------------------------------------------------------------------------------
+// TilePathfinder.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Point-to-point A* over a tile solidity bitset, accelerated with Jump Point Search.
+// Moves are 8-way and diagonals cannot cut the corner of a solid tile, the same rules as FlowField.
+// Per-tile search state lives in an arena sized to the map and is reset lazily by a search stamp,
+// and the open list is a reused binary heap, so a query never allocates after warm-up.
+// Finished paths are cached by (start tile, goal tile) until the solidity version changes.
+class TilePathfinder
+{
+public:
+    void Initialize(IntVec2 const& dimensions, std::vector<uint64_t> const* solidTileBits);
+    bool FindPath(IntVec2 const& startTileCoords, IntVec2 const& goalTileCoords, unsigned int solidityVersion, std::vector<IntVec2>& out_waypoints);
+    bool FindPathUncached(IntVec2 const& startTileCoords, IntVec2 const& goalTileCoords, std::vector<IntVec2>& out_waypoints);
+    void ClearCache();
+
+    int GetCacheSize() const;
+    int GetLastExpandedCount() const;
+
+#if defined(GAME_BENCHMARKS)
+    static void RunBenchmark();
+#endif
+
+    static constexpr int MAX_CACHED_PATH_COUNT = 1024;
+
+private:
+    static float GetOctileDistance(int deltaX, int deltaY);
+
+    bool IsWalkable(int x, int y) const;
+    bool IsWalkableDiagonalStep(int x, int y, int dx, int dy) const;
+    bool JumpStraight(int x, int y, int dx, int dy, IntVec2 const& goalTileCoords, IntVec2& out_jumpPoint) const;
+    bool JumpDiagonal(int x, int y, int dx, int dy, IntVec2 const& goalTileCoords, IntVec2& out_jumpPoint) const;
+    void AddJumpSuccessor(int parentIndex, int dx, int dy, IntVec2 const& goalTileCoords);
+    void PushOpen(int tileIndex, float fScore);
+
+    struct SearchNode
+    {
+        float        m_gScore      = 0.f;
+        int          m_parentIndex = -1;
+        unsigned int m_openStamp   = 0;     // Equal to m_searchStamp once the node was reached in the current search.
+        unsigned int m_closedStamp = 0;     // Equal to m_searchStamp once the node was expanded in the current search.
+    };
+
+    struct OpenEntry
+    {
+        float m_fScore    = 0.f;
+        int   m_tileIndex = 0;
+    };
+
+    IntVec2                      m_dimensions    = IntVec2::ZERO;
+    std::vector<uint64_t> const* m_solidTileBits = nullptr;     // One bit per tile, indexed by x + y * m_dimensions.x. Not owned.
+    std::vector<SearchNode>      m_nodes;                       // Search arena, one node per tile.
+    std::vector<OpenEntry>       m_openHeap;                    // Smallest f-score on top; stale entries are skipped when popped.
+    unsigned int                 m_searchStamp       = 0;
+    int                          m_lastExpandedCount = 0;
+
+    std::unordered_map<uint64_t, std::vector<IntVec2>> m_pathCache;            // Keyed by startIndex << 32 | goalIndex. An empty path means unreachable.
+    unsigned int                                       m_cacheSolidityVersion = 0;
+};
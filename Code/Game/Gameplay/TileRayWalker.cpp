@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------------------------------
+// TileRayWalker.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/TileRayWalker.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+TileRayWalker::TileRayWalker(Vec3 const& startPosition,
+                             Vec3 const& forwardNormal)
+{
+    float const forwardNormalX = forwardNormal.x;
+    float const forwardNormalY = forwardNormal.y;
+
+    m_tileCoords   = IntVec2(RoundDownToInt(startPosition.x), RoundDownToInt(startPosition.y));
+    m_tileStepX    = forwardNormalX > 0.f ? 1 : -1;
+    m_tileStepY    = forwardNormalY > 0.f ? 1 : -1;
+    m_deltaLengthX = forwardNormalX != 0.f ? 1.f / fabsf(forwardNormalX) : FLOAT_MAX;
+    m_deltaLengthY = forwardNormalY != 0.f ? 1.f / fabsf(forwardNormalY) : FLOAT_MAX;
+
+    float const firstEdgeX = static_cast<float>(m_tileCoords.x + (m_tileStepX > 0 ? 1 : 0));
+    float const firstEdgeY = static_cast<float>(m_tileCoords.y + (m_tileStepY > 0 ? 1 : 0));
+
+    m_firstLengthX = forwardNormalX != 0.f ? (firstEdgeX - startPosition.x) / forwardNormalX : FLOAT_MAX;
+    m_firstLengthY = forwardNormalY != 0.f ? (firstEdgeY - startPosition.y) / forwardNormalY : FLOAT_MAX;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A ray with no XY component never crosses a tile edge, so Step must not be called on it.
+bool TileRayWalker::IsMoving() const
+{
+    return m_deltaLengthX != FLOAT_MAX || m_deltaLengthY != FLOAT_MAX;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Into the next tile through whichever edge is closer, recording which face it entered through.
+void TileRayWalker::Step()
+{
+    float const nextLengthX = GetCrossingLength(m_firstLengthX, m_deltaLengthX, m_crossingCountX);
+    float const nextLengthY = GetCrossingLength(m_firstLengthY, m_deltaLengthY, m_crossingCountY);
+
+    if (nextLengthX < nextLengthY)
+    {
+        m_entryLength = nextLengthX;
+        m_crossingCountX++;
+        m_tileCoords.x += m_tileStepX;
+        m_entryNormal = IntVec2(-m_tileStepX, 0);
+    }
+    else
+    {
+        m_entryLength = nextLengthY;
+        m_crossingCountY++;
+        m_tileCoords.y += m_tileStepY;
+        m_entryNormal = IntVec2(0, -m_tileStepY);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Leaves the block containing the current tile in one step, into the tile a run of Steps would first reach outside it.
+// crossingsX/Y edges remain on each axis before the block's far side; the earlier exit wins, and the other axis advances
+// by the edges it crosses before that (ties go to Y, as in Step).
+void TileRayWalker::SkipBlock(IntVec2 const& blockMins,
+                              int const      blockSize)
+{
+    int const   crossingsX  = m_tileStepX > 0 ? blockMins.x + blockSize - m_tileCoords.x : m_tileCoords.x - blockMins.x + 1;
+    int const   crossingsY  = m_tileStepY > 0 ? blockMins.y + blockSize - m_tileCoords.y : m_tileCoords.y - blockMins.y + 1;
+    float const exitLengthX = GetCrossingLength(m_firstLengthX, m_deltaLengthX, m_crossingCountX + crossingsX - 1);
+    float const exitLengthY = GetCrossingLength(m_firstLengthY, m_deltaLengthY, m_crossingCountY + crossingsY - 1);
+
+    if (exitLengthX < exitLengthY)
+    {
+        int const newCrossingCountY = CountCrossingsUpTo(m_firstLengthY, m_deltaLengthY, m_crossingCountY, exitLengthX, true);
+
+        m_entryLength = exitLengthX;
+        m_tileCoords.x += m_tileStepX * crossingsX;
+        m_tileCoords.y += m_tileStepY * (newCrossingCountY - m_crossingCountY);
+        m_crossingCountX += crossingsX;
+        m_crossingCountY = newCrossingCountY;
+        m_entryNormal    = IntVec2(-m_tileStepX, 0);
+    }
+    else
+    {
+        int const newCrossingCountX = CountCrossingsUpTo(m_firstLengthX, m_deltaLengthX, m_crossingCountX, exitLengthY, false);
+
+        m_entryLength = exitLengthY;
+        m_tileCoords.x += m_tileStepX * (newCrossingCountX - m_crossingCountX);
+        m_tileCoords.y += m_tileStepY * crossingsY;
+        m_crossingCountX = newCrossingCountX;
+        m_crossingCountY += crossingsY;
+        m_entryNormal = IntVec2(0, -m_tileStepY);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 TileRayWalker::GetTileCoords() const
+{
+    return m_tileCoords;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Ray length at which the current tile was entered; 0 for the start tile.
+float TileRayWalker::GetEntryLength() const
+{
+    return m_entryLength;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Normal of the edge the current tile was entered through; zero for the start tile.
+IntVec2 TileRayWalker::GetEntryNormal() const
+{
+    return m_entryNormal;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC float TileRayWalker::GetCrossingLength(float const firstLength,
+                                              float const deltaLength,
+                                              int const   crossingIndex)
+{
+    if (deltaLength == FLOAT_MAX) return FLOAT_MAX;
+
+    return firstLength + static_cast<float>(crossingIndex) * deltaLength;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Number of edges on one axis crossed at or before length (strictly before when isInclusive is false), given that the first
+// crossingCount edges are already known to be crossed. The estimate from a division is corrected with the exact
+// crossing lengths, so it agrees with stepping edge by edge.
+STATIC int TileRayWalker::CountCrossingsUpTo(float const firstLength,
+                                             float const deltaLength,
+                                             int const   crossingCount,
+                                             float const length,
+                                             bool const  isInclusive)
+{
+    if (deltaLength == FLOAT_MAX) return crossingCount;
+
+    auto const isCrossed = [firstLength, deltaLength, length, isInclusive](int crossingIndex)
+    {
+        float const crossingLength = GetCrossingLength(firstLength, deltaLength, crossingIndex);
+
+        return isInclusive ? crossingLength <= length : crossingLength < length;
+    };
+
+    int count = RoundDownToInt((length - firstLength) / deltaLength) + 1;
+
+    if (count < crossingCount) count = crossingCount;
+
+    while (count > crossingCount && !isCrossed(count - 1)) count--;
+    while (isCrossed(count)) count++;
+
+    return count;
+}
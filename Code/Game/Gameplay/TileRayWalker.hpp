@@ -0,0 +1,65 @@
+//----------------------------------------------------------------------------------------------------
+// TileRayWalker.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Grid traversal (Amanatides-Woo) over the unit tiles an XY ray enters, shared by every query that walks tiles along a ray.
+// The ray crosses its i-th edge on an axis at firstLength + i * deltaLength, computed from the crossing count rather than
+// accumulated, so SkipBlock lands exactly where tile-by-tile Steps would and every walker of the same ray sees the same lengths.
+// Ties between an X and a Y edge step in Y.
+class TileRayWalker
+{
+public:
+    TileRayWalker(Vec3 const& startPosition, Vec3 const& forwardNormal);
+
+    bool    IsMoving() const;
+    void    Step();
+    void    SkipBlock(IntVec2 const& blockMins, int blockSize);
+
+    IntVec2 GetTileCoords() const;
+    float   GetEntryLength() const;
+    IntVec2 GetEntryNormal() const;
+
+    // Calls visitTile(walker) for the start tile and then every tile entered up to maxLength, until it returns false.
+    template <typename TileFunction>
+    void Walk(float maxLength, TileFunction const& visitTile);
+
+private:
+    static float GetCrossingLength(float firstLength, float deltaLength, int crossingIndex);
+    static int   CountCrossingsUpTo(float firstLength, float deltaLength, int crossingCount, float length, bool isInclusive);
+
+    IntVec2 m_tileCoords;
+    int     m_tileStepX      = 0;
+    int     m_tileStepY      = 0;
+    float   m_deltaLengthX   = 0.f;     // Ray length between two X edges, FLOAT_MAX when the ray never crosses one.
+    float   m_deltaLengthY   = 0.f;
+    float   m_firstLengthX   = 0.f;     // Ray length at the first X edge.
+    float   m_firstLengthY   = 0.f;
+    int     m_crossingCountX = 0;       // X edges crossed so far.
+    int     m_crossingCountY = 0;
+    float   m_entryLength    = 0.f;
+    IntVec2 m_entryNormal;
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename TileFunction>
+void TileRayWalker::Walk(float const         maxLength,
+                         TileFunction const& visitTile)
+{
+    if (!visitTile(*this)) return;
+
+    if (!IsMoving()) return;
+
+    while (true)
+    {
+        Step();
+
+        if (m_entryLength > maxLength) return;
+        if (!visitTile(*this)) return;
+    }
+}
@@ -0,0 +1,368 @@
+//----------------------------------------------------------------------------------------------------
+// TileVisibilitySet.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/TileVisibilitySet.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <utility>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void TileVisibilitySet::LoadOrBake(IntVec2 const&               dimensions,
+                                   std::vector<uint64_t> const& solidTileBits,
+                                   unsigned int const           solidityVersion,
+                                   String const&                cacheFilePath)
+{
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    m_dimensions      = dimensions;
+    m_solidityVersion = solidityVersion;
+
+    // 1. Index the open tiles and lay out the triangular rows.
+    m_openTileIndices.assign(static_cast<size_t>(dimensions.x) * dimensions.y, -1);
+    m_openTileCoords.clear();
+
+    for (int y = 0; y < dimensions.y; ++y)
+    {
+        for (int x = 0; x < dimensions.x; ++x)
+        {
+            if (IsSolid(x, y, solidTileBits)) continue;
+
+            m_openTileIndices[x + y * dimensions.x] = static_cast<int>(m_openTileCoords.size());
+            m_openTileCoords.push_back(IntVec2(x, y));
+        }
+    }
+
+    int const openTileCount = static_cast<int>(m_openTileCoords.size());
+
+    m_rowWordOffsets.resize(openTileCount);
+
+    uint32_t wordCount = 0;
+
+    for (int rowIndex = 0; rowIndex < openTileCount; ++rowIndex)
+    {
+        m_rowWordOffsets[rowIndex] = wordCount;
+        wordCount += static_cast<uint32_t>(rowIndex + 1 + 63) / 64;
+    }
+
+    m_visibilityBits.assign(wordCount, 0);
+
+    // 2. Reuse the cached bake when the solidity matches, otherwise bake and save it.
+    uint64_t const solidityHash = GetSolidityHash(solidTileBits);
+
+    m_wasLoadedFromCache = LoadFromFile(cacheFilePath, solidityHash);
+
+    if (!m_wasLoadedFromCache)
+    {
+        Bake(solidTileBits);
+        SaveToFile(cacheFilePath, solidityHash);
+    }
+
+    m_bakeSeconds = GetCurrentTimeSeconds() - startSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Conservative: returns true whenever the set cannot answer (solid or out-of-map tiles, or changed solidity),
+// so callers only ever skip ray work for pairs that are known to be blocked.
+bool TileVisibilitySet::IsPotentiallyVisible(IntVec2 const&     tileCoordsA,
+                                             IntVec2 const&     tileCoordsB,
+                                             unsigned int const solidityVersion) const
+{
+    if (solidityVersion != m_solidityVersion) return true;
+
+    if (tileCoordsA.x < 0 || tileCoordsA.y < 0 || tileCoordsA.x >= m_dimensions.x || tileCoordsA.y >= m_dimensions.y) return true;
+    if (tileCoordsB.x < 0 || tileCoordsB.y < 0 || tileCoordsB.x >= m_dimensions.x || tileCoordsB.y >= m_dimensions.y) return true;
+
+    int const openIndexA = m_openTileIndices[tileCoordsA.x + tileCoordsA.y * m_dimensions.x];
+    int const openIndexB = m_openTileIndices[tileCoordsB.x + tileCoordsB.y * m_dimensions.x];
+
+    if (openIndexA < 0 || openIndexB < 0) return true;
+
+    int const rowIndex    = openIndexA > openIndexB ? openIndexA : openIndexB;
+    int const columnIndex = openIndexA > openIndexB ? openIndexB : openIndexA;
+
+    return (m_visibilityBits[m_rowWordOffsets[rowIndex] + (columnIndex >> 6)] >> (columnIndex & 63) & 1ull) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TileVisibilitySet::GetOpenTileCount() const
+{
+    return static_cast<int>(m_openTileCoords.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t TileVisibilitySet::GetSizeBytes() const
+{
+    return m_visibilityBits.size() * sizeof(uint64_t);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TileVisibilitySet::WasLoadedFromCache() const
+{
+    return m_wasLoadedFromCache;
+}
+
+//----------------------------------------------------------------------------------------------------
+double TileVisibilitySet::GetBakeSeconds() const
+{
+    return m_bakeSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Rows are handed out through an atomic counter. Each row owns whole words, so the threads never write the same word.
+void TileVisibilitySet::Bake(std::vector<uint64_t> const& solidTileBits)
+{
+    int const        openTileCount = static_cast<int>(m_openTileCoords.size());
+    std::atomic<int> nextRowIndex  = 0;
+    unsigned int     threadCount   = std::thread::hardware_concurrency();
+
+    if (threadCount == 0) threadCount = 1;
+
+    auto const bakeRows = [this, &nextRowIndex, &solidTileBits, openTileCount]()
+    {
+        BakeScratch scratch;
+        scratch.m_visitStamps.assign(static_cast<size_t>(m_dimensions.x) * m_dimensions.y, -1);
+
+        for (int rowIndex = nextRowIndex++; rowIndex < openTileCount; rowIndex = nextRowIndex++)
+        {
+            BakeRow(rowIndex, solidTileBits, scratch);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+
+    for (unsigned int threadIndex = 1; threadIndex < threadCount; ++threadIndex)
+    {
+        threads.emplace_back(bakeRows);
+    }
+
+    bakeRows();
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileVisibilitySet::BakeRow(int const                    rowIndex,
+                                std::vector<uint64_t> const& solidTileBits,
+                                BakeScratch&                 scratch)
+{
+    IntVec2 const rowTileCoords = m_openTileCoords[rowIndex];
+    uint64_t*     rowWords      = &m_visibilityBits[m_rowWordOffsets[rowIndex]];
+
+    for (int columnIndex = 0; columnIndex <= rowIndex; ++columnIndex)
+    {
+        bool const isVisible = columnIndex == rowIndex || IsConnectedInsideHull(rowTileCoords, m_openTileCoords[columnIndex], solidTileBits, scratch);
+
+        if (isVisible)
+        {
+            rowWords[columnIndex >> 6] |= 1ull << (columnIndex & 63);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Flood fill from A over open tiles that touch the hull of A and B. Diagonal steps and tiles that only graze the hull
+// can only add connections, so the answer errs toward visible.
+bool TileVisibilitySet::IsConnectedInsideHull(IntVec2 const&               tileCoordsA,
+                                              IntVec2 const&               tileCoordsB,
+                                              std::vector<uint64_t> const& solidTileBits,
+                                              BakeScratch&                 scratch) const
+{
+    int const visitStamp = scratch.m_visitStamp++;
+
+    scratch.m_openList.clear();
+    scratch.m_openList.push_back(tileCoordsA);
+    scratch.m_visitStamps[tileCoordsA.x + tileCoordsA.y * m_dimensions.x] = visitStamp;
+
+    while (!scratch.m_openList.empty())
+    {
+        IntVec2 const tileCoords = scratch.m_openList.back();
+        scratch.m_openList.pop_back();
+
+        for (int offsetY = -1; offsetY <= 1; ++offsetY)
+        {
+            for (int offsetX = -1; offsetX <= 1; ++offsetX)
+            {
+                IntVec2 const neighborCoords(tileCoords.x + offsetX, tileCoords.y + offsetY);
+
+                if (IsSolid(neighborCoords.x, neighborCoords.y, solidTileBits)) continue;
+
+                int& neighborStamp = scratch.m_visitStamps[neighborCoords.x + neighborCoords.y * m_dimensions.x];
+
+                if (neighborStamp == visitStamp) continue;
+                if (!IsTileTouchingHull(neighborCoords, tileCoordsA, tileCoordsB)) continue;
+                if (neighborCoords == tileCoordsB) return true;
+
+                neighborStamp = visitStamp;
+                scratch.m_openList.push_back(neighborCoords);
+            }
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TileVisibilitySet::IsSolid(int const                    x,
+                                int const                    y,
+                                std::vector<uint64_t> const& solidTileBits) const
+{
+    if (x < 0 || y < 0 || x >= m_dimensions.x || y >= m_dimensions.y) return true;
+
+    int const tileIndex = x + y * m_dimensions.x;
+
+    return (solidTileBits[tileIndex >> 6] >> (tileIndex & 63) & 1ull) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The hull of two unit tiles is the segment between their min corners swept by a unit tile, so a tile touches it exactly when
+// that segment touches the 2x2 box around the tile's min corner. The box is padded slightly so float error only ever adds tiles.
+STATIC bool TileVisibilitySet::IsTileTouchingHull(IntVec2 const& tileCoords,
+                                                  IntVec2 const& tileCoordsA,
+                                                  IntVec2 const& tileCoordsB)
+{
+    float tMin = 0.f;
+    float tMax = 1.f;
+
+    int const starts[2]  = { tileCoordsA.x, tileCoordsA.y };
+    int const deltas[2]  = { tileCoordsB.x - tileCoordsA.x, tileCoordsB.y - tileCoordsA.y };
+    int const centers[2] = { tileCoords.x, tileCoords.y };
+
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        float const boxMin = static_cast<float>(centers[axis] - starts[axis]) - 1.01f;
+        float const boxMax = static_cast<float>(centers[axis] - starts[axis]) + 1.01f;
+
+        if (deltas[axis] == 0)
+        {
+            if (boxMin > 0.f || boxMax < 0.f) return false;
+            continue;
+        }
+
+        float t0 = boxMin / static_cast<float>(deltas[axis]);
+        float t1 = boxMax / static_cast<float>(deltas[axis]);
+
+        if (t0 > t1) std::swap(t0, t1);
+        if (t0 > tMin) tMin = t0;
+        if (t1 < tMax) tMax = t1;
+        if (tMin > tMax) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// File layout: magic, version, solidity hash, dimensions, word count, then the visibility words.
+bool TileVisibilitySet::LoadFromFile(String const&  cacheFilePath,
+                                     uint64_t const solidityHash)
+{
+    std::ifstream file(cacheFilePath, std::ios::binary);
+
+    if (!file.is_open()) return false;
+
+    uint32_t magic     = 0;
+    uint32_t version   = 0;
+    uint64_t hash      = 0;
+    int32_t  sizeX     = 0;
+    int32_t  sizeY     = 0;
+    uint32_t wordCount = 0;
+
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+    file.read(reinterpret_cast<char*>(&sizeX), sizeof(sizeX));
+    file.read(reinterpret_cast<char*>(&sizeY), sizeof(sizeY));
+    file.read(reinterpret_cast<char*>(&wordCount), sizeof(wordCount));
+
+    if (!file ||
+        magic != FILE_MAGIC ||
+        version != FILE_VERSION ||
+        hash != solidityHash ||
+        sizeX != m_dimensions.x ||
+        sizeY != m_dimensions.y ||
+        wordCount != static_cast<uint32_t>(m_visibilityBits.size()))
+    {
+        return false;
+    }
+
+    file.read(reinterpret_cast<char*>(m_visibilityBits.data()), static_cast<std::streamsize>(wordCount * sizeof(uint64_t)));
+
+    if (!file)
+    {
+        std::fill(m_visibilityBits.begin(), m_visibilityBits.end(), 0);
+        return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A failed save only costs a rebake next time, so it is reported and otherwise ignored.
+void TileVisibilitySet::SaveToFile(String const&  cacheFilePath,
+                                   uint64_t const solidityHash) const
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(std::filesystem::path(cacheFilePath).parent_path(), errorCode);
+
+    std::ofstream file(cacheFilePath, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        DebuggerPrintf("WARNING: could not write PVS cache \"%s\"\n", cacheFilePath.c_str());
+        return;
+    }
+
+    uint32_t const magic     = FILE_MAGIC;
+    uint32_t const version   = FILE_VERSION;
+    int32_t const  sizeX     = m_dimensions.x;
+    int32_t const  sizeY     = m_dimensions.y;
+    uint32_t const wordCount = static_cast<uint32_t>(m_visibilityBits.size());
+
+    file.write(reinterpret_cast<char const*>(&magic), sizeof(magic));
+    file.write(reinterpret_cast<char const*>(&version), sizeof(version));
+    file.write(reinterpret_cast<char const*>(&solidityHash), sizeof(solidityHash));
+    file.write(reinterpret_cast<char const*>(&sizeX), sizeof(sizeX));
+    file.write(reinterpret_cast<char const*>(&sizeY), sizeof(sizeY));
+    file.write(reinterpret_cast<char const*>(&wordCount), sizeof(wordCount));
+    file.write(reinterpret_cast<char const*>(m_visibilityBits.data()), static_cast<std::streamsize>(wordCount * sizeof(uint64_t)));
+}
+
+//----------------------------------------------------------------------------------------------------
+// FNV-1a over the dimensions and the solidity bits. Solidity is all the bake reads, so it is a tighter key
+// than the raw map image: recoloring a floor tile does not invalidate the cache, but changing TileDefinitions does.
+uint64_t TileVisibilitySet::GetSolidityHash(std::vector<uint64_t> const& solidTileBits) const
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    auto const hashWord = [&hash](uint64_t word)
+    {
+        for (int byteIndex = 0; byteIndex < 8; ++byteIndex)
+        {
+            hash ^= word >> (byteIndex * 8) & 0xffull;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    hashWord(static_cast<uint64_t>(m_dimensions.x));
+    hashWord(static_cast<uint64_t>(m_dimensions.y));
+
+    for (uint64_t const word : solidTileBits)
+    {
+        hashWord(word);
+    }
+
+    return hash;
+}
@@ -0,0 +1,63 @@
+//----------------------------------------------------------------------------------------------------
+// TileVisibilitySet.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Precomputed tile-to-tile potentially visible set (PVS) for the map's solidity grid.
+// Only open tiles get an index, and visibility is symmetric, so only the lower triangle of the open-tile pair matrix is stored:
+// row i holds the bits for open tiles 0..i, padded to whole 64-bit words so bake threads never share a word.
+// Walls span the full map height, so XY decides line of sight. Every segment between two tiles lies in the convex hull of the pair,
+// and a clear segment crosses only open tiles, so a pair is marked blocked only when no 8-connected chain of open tiles touching
+// that hull links the two; a pair marked blocked is therefore blocked for every point in both tiles.
+// The bake runs on all hardware threads and is cached to disk, keyed by a hash of the map's dimensions and solidity.
+class TileVisibilitySet
+{
+public:
+    void LoadOrBake(IntVec2 const& dimensions, std::vector<uint64_t> const& solidTileBits, unsigned int solidityVersion, String const& cacheFilePath);
+    bool IsPotentiallyVisible(IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB, unsigned int solidityVersion) const;
+
+    int    GetOpenTileCount() const;
+    size_t GetSizeBytes() const;
+    bool   WasLoadedFromCache() const;
+    double GetBakeSeconds() const;
+
+    // Bump FILE_VERSION when the bake rules or the file layout change, so stale cache files are rebaked.
+    static constexpr uint32_t FILE_MAGIC   = 0x53565050u;   // "PPVS"
+    static constexpr uint32_t FILE_VERSION = 2u;
+
+private:
+    // Per bake thread flood state, so the threads never share it.
+    struct BakeScratch
+    {
+        std::vector<int>     m_visitStamps;         // Per tile, the stamp of the last flood that reached it.
+        std::vector<IntVec2> m_openList;
+        int                  m_visitStamp = 0;
+    };
+
+    void     Bake(std::vector<uint64_t> const& solidTileBits);
+    void     BakeRow(int rowIndex, std::vector<uint64_t> const& solidTileBits, BakeScratch& scratch);
+    bool     IsConnectedInsideHull(IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB, std::vector<uint64_t> const& solidTileBits, BakeScratch& scratch) const;
+    bool     IsSolid(int x, int y, std::vector<uint64_t> const& solidTileBits) const;
+    bool     LoadFromFile(String const& cacheFilePath, uint64_t solidityHash);
+    void     SaveToFile(String const& cacheFilePath, uint64_t solidityHash) const;
+    uint64_t GetSolidityHash(std::vector<uint64_t> const& solidTileBits) const;
+
+    static bool IsTileTouchingHull(IntVec2 const& tileCoords, IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB);
+
+    IntVec2               m_dimensions      = IntVec2::ZERO;
+    unsigned int          m_solidityVersion = 0;        // Map solidity version baked against; other versions get no rejection.
+    std::vector<int>      m_openTileIndices;            // Open tile index per tile, -1 for solid tiles. Indexed by x + y * m_dimensions.x.
+    std::vector<IntVec2>  m_openTileCoords;             // Tile coords per open tile index.
+    std::vector<uint32_t> m_rowWordOffsets;             // First word of each row in m_visibilityBits.
+    std::vector<uint64_t> m_visibilityBits;
+    bool                  m_wasLoadedFromCache = false;
+    double                m_bakeSeconds        = 0.0;
+};
@@ -10,13 +10,13 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/Timer.hpp"
 #include "Engine/Math/MathUtils.hpp"
-#include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Game/Gameplay/Actor.hpp"
 #include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Framework/ActorHandle.hpp"
 #include "Game/Framework/Animation.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Framework/GameCommon.hpp"
@@ -24,6 +24,7 @@
 #include "Game/Gameplay/Map.hpp"
 #include "Game/Definition/MapDefinition.hpp"
 #include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/RenderStats.hpp"
 #include "Game/Gameplay/Sound.hpp"
 #include "Game/Definition/WeaponDefinition.hpp"
 
@@ -50,6 +51,9 @@ Weapon::Weapon(Actor*            owner,
 //----------------------------------------------------------------------------------------------------
 Weapon::~Weapon()
 {
+    SafeDeletePointer(m_timer);
+    SafeDeletePointer(m_animationTimer);
+
     m_owner = nullptr;
 }
 
@@ -93,6 +97,7 @@ void Weapon::RenderWeaponBase() const
     AddVertsForAABB2D(vertexes, m_hudBaseBound, Rgba8::WHITE);
     g_theRenderer->BindTexture(baseTexture);
     g_theRenderer->DrawVertexArray(vertexes);
+    g_renderStats.AddDrawCall(vertexes.size() * sizeof(Vertex_PCU));
 }
 
 void Weapon::RenderWeaponReticule() const
@@ -119,6 +124,7 @@ void Weapon::RenderWeaponReticule() const
     AddVertsForAABB2D(vertexes, reticleBound, Rgba8::WHITE);
     g_theRenderer->BindTexture(reticleTexture);
     g_theRenderer->DrawVertexArray(vertexes);
+    g_renderStats.AddDrawCall(vertexes.size() * sizeof(Vertex_PCU));
 }
 
 void Weapon::RenderWeaponHudText() const
@@ -141,6 +147,7 @@ void Weapon::RenderWeaponHudText() const
     // Vec2(0.95f, 0.5f));
     g_theRenderer->BindTexture(&g_testFont->GetTexture());
     g_theRenderer->DrawVertexArray(vertexes);
+    g_renderStats.AddDrawCall(vertexes.size() * sizeof(Vertex_PCU));
     // g_theRenderer->BindTexture(nullptr);
 }
 
@@ -177,6 +184,7 @@ void Weapon::RenderWeaponAnim() const
     AddVertsForAABB2D(vertexes, uvAtTime, Rgba8::WHITE);
     g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
     g_theRenderer->DrawVertexArray(vertexes);
+    g_renderStats.AddDrawCall(vertexes.size() * sizeof(Vertex_PCU));
 }
 
 
@@ -213,7 +221,7 @@ void Weapon::Fire()
             m_timer->DecrementPeriodIfElapsed();
             m_lastFireTime = m_currentFireTime;
             // if (m_owner == nullptr) return;
-            while (rayCount > 0)
+            if (rayCount > 0)
             {
                 //float             rayRange = m_definition->m_rayRange;
                 Vec3              forward, left, up;
@@ -221,40 +229,55 @@ void Weapon::Fire()
                 Vec3 const        fireEyePosition = firePosition + Vec3(0.f, 0.f, m_owner->m_definition->m_eyeHeight);
                 EulerAngles const fireOrientation = m_owner->m_orientation;
                 fireOrientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
-                ActorHandle           impactedActorHandle;
-                RaycastResult3D const result        = m_owner->m_map->RaycastAll(m_owner, impactedActorHandle, fireEyePosition, forward, 10.f);
-                Actor*                impactedActor = m_owner->m_map->GetActorByHandle(impactedActorHandle);
 
-                if (result.m_didImpact)
-                {
-                    // DebugAddWorldPoint(result.m_impactPosition, 0.06f, 10.f);
-                    // DebugAddWorldCylinder(fireEyePosition - Vec3::Z_BASIS * 0.05f, result.m_impactPosition, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::X_RAY);
-                    // DebugAddWorldCylinder(fireEyePosition - Vec3::Z_BASIS * 0.05f, result.m_impactPosition, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::USE_DEPTH);
-                    SpawnInfo particleSpawnInfo;
-                    particleSpawnInfo.m_position   = result.m_impactPosition;
-                    particleSpawnInfo.m_position.x = GetClamped(particleSpawnInfo.m_position.x, 0.f, 31.f);
-                    particleSpawnInfo.m_position.y = GetClamped(particleSpawnInfo.m_position.y, 0.f, 31.f);
-                    particleSpawnInfo.m_name       = "BulletHit";
-                    g_theGame->m_currentMap->SpawnActor(particleSpawnInfo);
-                }
-                else
-                {
-                    // DebugAddWorldCylinder(fireEyePosition - Vec3::Z_BASIS * 0.05f, result.m_rayStartPosition + result.m_rayForwardNormal * rayRange, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::USE_DEPTH);
-                }
+                // Every pellet leaves the eye at once, so the volley is resolved by batched queries over buffers on the stack.
+                Vec3            rayForwardNormals[MAX_VOLLEY_RAY_COUNT];
+                RaycastResult3D rayResults[MAX_VOLLEY_RAY_COUNT];
+                ActorHandle     rayImpactedActorHandles[MAX_VOLLEY_RAY_COUNT];
 
-                if (impactedActor != nullptr && impactedActor != m_owner)
+                for (int volleyRayIndex = 0; volleyRayIndex < rayCount; volleyRayIndex += MAX_VOLLEY_RAY_COUNT)
                 {
-                    impactedActor->Damage((int)m_definition->m_rayDamage.m_min, m_owner->m_handle);
-                    impactedActor->AddImpulse(m_definition->m_rayImpulse * forward);
+                    int const batchRayCount = rayCount - volleyRayIndex < MAX_VOLLEY_RAY_COUNT ? rayCount - volleyRayIndex : MAX_VOLLEY_RAY_COUNT;
 
-                    //float damage = g_theRNG->RollRandomFloatInRange(m_definition->m_rayDamage.m_min, m_definition->m_rayDamage.m_max);
+                    for (int rayIndex = 0; rayIndex < batchRayCount; ++rayIndex)
+                    {
+                        rayForwardNormals[rayIndex]       = forward;
+                        rayImpactedActorHandles[rayIndex] = ActorHandle::INVALID;
+                    }
+
+                    m_owner->m_map->RaycastBatch(m_owner, fireEyePosition, rayForwardNormals, batchRayCount, 10.f, rayResults, rayImpactedActorHandles);
 
-                    SpawnInfo particleSpawnInfo;
-                    particleSpawnInfo.m_position = result.m_impactPosition;
-                    particleSpawnInfo.m_name     = "BloodSplatter";
-                    g_theGame->m_currentMap->SpawnActor(particleSpawnInfo);
+                    for (int rayIndex = 0; rayIndex < batchRayCount; ++rayIndex)
+                    {
+                        RaycastResult3D const& result        = rayResults[rayIndex];
+                        Actor*                 impactedActor = m_owner->m_map->GetActorByHandle(rayImpactedActorHandles[rayIndex]);
+
+                        if (result.m_didImpact)
+                        {
+                            // DebugAddWorldPoint(result.m_impactPosition, 0.06f, 10.f);
+                            // DebugAddWorldCylinder(fireEyePosition - Vec3::Z_BASIS * 0.05f, result.m_impactPosition, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::X_RAY);
+                            // DebugAddWorldCylinder(fireEyePosition - Vec3::Z_BASIS * 0.05f, result.m_impactPosition, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::USE_DEPTH);
+                            Vec3 particlePosition = result.m_impactPosition;
+                            particlePosition.x    = GetClamped(particlePosition.x, 0.f, 31.f);
+                            particlePosition.y    = GetClamped(particlePosition.y, 0.f, 31.f);
+                            m_owner->m_map->SpawnEffect("BulletHit", particlePosition);
+                        }
+                        else
+                        {
+                            // DebugAddWorldCylinder(fireEyePosition - Vec3::Z_BASIS * 0.05f, result.m_rayStartPosition + result.m_rayForwardNormal * rayRange, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::USE_DEPTH);
+                        }
+
+                        if (impactedActor != nullptr && impactedActor != m_owner)
+                        {
+                            impactedActor->Damage((int)m_definition->m_rayDamage.m_min, m_owner->m_handle);
+                            impactedActor->AddImpulse(m_definition->m_rayImpulse * rayForwardNormals[rayIndex]);
+
+                            //float damage = g_theRNG->RollRandomFloatInRange(m_definition->m_rayDamage.m_min, m_definition->m_rayDamage.m_max);
+
+                            m_owner->m_map->SpawnEffect("BloodSplatter", result.m_impactPosition);
+                        }
+                    }
                 }
-                rayCount--;
             }
 
             while (projectileCount > 0)
@@ -315,7 +338,7 @@ void Weapon::Fire()
                 }
                 if (bestTarget)
                 {
-                    float damage = g_theRNG->RollRandomFloatInRange(m_definition->m_meleeDamage.m_min, m_definition->m_meleeDamage.m_max);
+                    float damage = m_owner->GetRandomStream().RollRandomFloatInRange(m_definition->m_meleeDamage.m_min, m_definition->m_meleeDamage.m_max);
                     bestTarget->Damage((int)damage, m_owner->m_handle);
                     bestTarget->AddImpulse(m_definition->m_meleeImpulse * fwd);
                 }
@@ -372,9 +395,10 @@ Animation* Weapon::PlayAnimationByName(std::string animationName, bool force)
 // This, and other utility methods, will be helpful for randomizing weapons with a cone.
 EulerAngles Weapon::GetRandomDirectionInCone(EulerAngles weaponOrientation, float degreeOfVariation)
 {
-    float const       randomYaw       = g_theRNG->RollRandomFloatInRange(-degreeOfVariation, degreeOfVariation);
-    float const       randomPitch     = g_theRNG->RollRandomFloatInRange(-degreeOfVariation, degreeOfVariation);
-    float const       randomRow       = g_theRNG->RollRandomFloatInRange(-degreeOfVariation, degreeOfVariation);
+    RandomStream&     randomStream    = m_owner->GetRandomStream();
+    float const       randomYaw       = randomStream.RollRandomFloatInRange(-degreeOfVariation, degreeOfVariation);
+    float const       randomPitch     = randomStream.RollRandomFloatInRange(-degreeOfVariation, degreeOfVariation);
+    float const       randomRow       = randomStream.RollRandomFloatInRange(-degreeOfVariation, degreeOfVariation);
     EulerAngles const randomDirection = EulerAngles(weaponOrientation.m_yawDegrees + randomYaw, weaponOrientation.m_pitchDegrees + randomPitch, weaponOrientation.m_rollDegrees + randomRow);
     return randomDirection;
 }
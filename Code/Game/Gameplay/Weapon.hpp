@@ -42,4 +42,6 @@ public:
 
     Animation* m_currentPlayingAnimation = nullptr;
     Timer*     m_animationTimer          = nullptr;
+
+    static constexpr int MAX_VOLLEY_RAY_COUNT = 32;   // Rays per batched query in Fire, which keeps its buffers on the stack and splits larger volleys.
 };
@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------------------------------
+// Diffuse lighting for the map mesh. Map quads may span several tiles: their UVs are in tile units,
+// and the sprite sheet cell to repeat is passed in the tangent (cell mins) and bitangent (cell maxs).
+//----------------------------------------------------------------------------------------------------
+struct vs_input_t
+{
+	float3 modelPosition : POSITION;
+	float4 color : COLOR;
+	float2 uv : TEXCOORD;
+	float3 modelTangent : TANGENT;
+	float3 modelBitangent : BITANGENT;
+	float3 modelNormal : NORMAL;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct v2p_t
+{
+	float4 clipPosition : SV_Position;
+	float4 color : COLOR;
+	float2 uv : TEXCOORD;
+	float2 atlasCellMins : ATLASCELLMINS;
+	float2 atlasCellMaxs : ATLASCELLMAXS;
+	float4 worldNormal : NORMAL;
+};
+
+//----------------------------------------------------------------------------------------------------
+cbuffer LightConstants : register(b1)
+{
+	float3 SunDirection;
+	float SunIntensity;
+	float AmbientIntensity;
+};
+
+//----------------------------------------------------------------------------------------------------
+cbuffer CameraConstants : register(b2)
+{
+	float4x4 WorldToCameraTransform;	// View transform
+	float4x4 CameraToRenderTransform;	// Non-standard transform from game to DirectX conventions
+	float4x4 RenderToClipTransform;		// Projection transform
+};
+
+//----------------------------------------------------------------------------------------------------
+cbuffer ModelConstants : register(b3)
+{
+	float4x4 ModelToWorldTransform;		// Model transform
+	float4 ModelColor;
+};
+
+//----------------------------------------------------------------------------------------------------
+Texture2D diffuseTexture : register(t0);
+
+//----------------------------------------------------------------------------------------------------
+SamplerState samplerState : register(s0);
+
+//----------------------------------------------------------------------------------------------------
+v2p_t VertexMain(vs_input_t input)
+{
+	float4 modelPosition = float4(input.modelPosition, 1);
+	float4 worldPosition = mul(ModelToWorldTransform, modelPosition);
+	float4 cameraPosition = mul(WorldToCameraTransform, worldPosition);
+	float4 renderPosition = mul(CameraToRenderTransform, cameraPosition);
+	float4 clipPosition = mul(RenderToClipTransform, renderPosition);
+
+	float4 worldNormal = mul(ModelToWorldTransform, float4(input.modelNormal, 0.0f));
+
+	v2p_t v2p;
+	v2p.clipPosition = clipPosition;
+	v2p.color = input.color;
+	v2p.uv = input.uv;
+	v2p.atlasCellMins = input.modelTangent.xy;
+	v2p.atlasCellMaxs = input.modelBitangent.xy;
+	v2p.worldNormal = worldNormal;
+	return v2p;
+}
+
+//----------------------------------------------------------------------------------------------------
+float4 PixelMain(v2p_t input) : SV_Target0
+{
+	float ambient = AmbientIntensity;
+	float directional = SunIntensity * saturate(dot(normalize(input.worldNormal.xyz), -SunDirection));
+	float4 lightColor = float4((ambient + directional).xxx, 1);
+	float2 atlasUV = lerp(input.atlasCellMins, input.atlasCellMaxs, frac(input.uv));
+	float4 textureColor = diffuseTexture.Sample(samplerState, atlasUV);
+	float4 vertexColor = input.color;
+	float4 modelColor = ModelColor;
+	float4 color = lightColor * textureColor * vertexColor * modelColor;
+	clip(color.a - 0.01f);
+	return color;
+}